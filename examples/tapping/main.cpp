@@ -34,11 +34,16 @@
 #include "plotting.hpp"
 #include "search.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cmdlp/parser.hpp>
 
+#include <flexman/async_logging.hpp>
+#include <flexman/executor.hpp>
 #include <flexman/pso/optimize.hpp>
 #include <flexman/serialization.hpp>
+#include <flexman/search/seed.hpp>
+#include <flexman/simulation/parareal.hpp>
 #include <flexman/simulation/simulate.hpp>
 
 namespace tapping
@@ -219,6 +224,50 @@ inline void save_results(
     }
 }
 
+template <typename SearchManager, typename Mode>
+inline auto load_seed(const SearchManager &manager, const std::vector<Mode> &modes, const std::string &filename)
+    -> tapping::pareto_front_t
+{
+    if (filename.empty()) {
+        return tapping::pareto_front_t{};
+    }
+    tapping::result_t prior;
+    json::jnode_t root = json::parser::parse_file(filename);
+    root["results"] >> prior;
+    return flexman::search::seed_pareto_front(&manager, modes, prior);
+}
+
+inline auto load_cost_model(const std::string &filename) -> std::shared_ptr<const flexman::search::CostModel>
+{
+    if (filename.empty()) {
+        return nullptr;
+    }
+    flexman::search::CostModel model;
+    json::jnode_t root = json::parser::parse_file(filename);
+    root >> model;
+    return std::make_shared<const flexman::search::CostModel>(std::move(model));
+}
+
+template <typename SearchManager, typename Mode>
+inline void train_cost_model(
+    const SearchManager &manager,
+    const std::vector<Mode> &modes,
+    const tapping::result_t &results,
+    const std::string &filename)
+{
+    flexman::search::CostSamples samples;
+    flexman::search::collect_cost_samples(&manager, modes, results, samples);
+    if (samples.features.empty()) {
+        std::cerr << "No samples to train the cost model.\n";
+        return;
+    }
+    json::jnode_t root;
+    root << flexman::search::fit_cost_model(samples);
+    if (!json::parser::write_file(filename, root, true, 4U)) {
+        std::cerr << "Failed to save to `" << filename << "`.\n";
+    }
+}
+
 void setup_option_parser(cmdlp::Parser &parser)
 {
     // Add the help.
@@ -248,6 +297,19 @@ void setup_option_parser(cmdlp::Parser &parser)
             std::to_string(algorithm_single_machine),
         },
         std::to_string(algorithm_heuristic));
+    // Select the integrator of the continuous mode.
+    parser.addMultiOption(
+        "-ig", "--integrator", "Integrate the continuous mode with (0) RK4, (1) Rosenbrock (stiff).",
+        {
+            std::to_string(tapping::integrator_rk4),
+            std::to_string(tapping::integrator_rosenbrock),
+        },
+        std::to_string(tapping::integrator_rk4));
+    parser.addOption("-ss", "--substeps", "The integration steps per time delta, in continuous mode", 100U, false);
+    // Parallel-in-time simulation.
+    parser.addOption(
+        "-pr", "--parareal", "Slices of a Parareal simulation, in continuous mode (0: serial simulation)", 0U, false);
+    parser.addToggle("-pv", "--parareal_verify", "Compare the Parareal simulation against the serial one", false);
     // Post-search optimization.
     parser.addToggle("-p", "--pso", "Enable post-search optimization using PSO", false);
     parser.addOption("-pn", "--pso_num_particles", "Number of particles in the PSO swarm", 100, false);
@@ -256,8 +318,16 @@ void setup_option_parser(cmdlp::Parser &parser)
         "-pi", "--pso_inertia", "Inertia weight for PSO (controls exploration vs exploitation)", .2, false);
     parser.addOption("-pc", "--pso_cognitive", "Cognitive weight for PSO (influence of personal best)", .4, false);
     parser.addOption("-ps", "--pso_social", "Social weight for PSO (influence of global best)", .4, false);
+    parser.addOption(
+        "-psi", "--pso_islands", "Number of PSO sub-swarms, running in parallel (1: single swarm)", 1U, false);
+    parser.addOption(
+        "-pmi", "--pso_migration_interval", "Iterations between two migrations among sub-swarms", 5U, false);
+    parser.addOption("-pmg", "--pso_migrants", "Particles sent by each sub-swarm at every migration", 1U, false);
     // Set the output file.
     parser.addOption("-o", "--output", "The file where the execution results are saved", "output.json", false);
+    parser.addOption("-se", "--seed", "A prior output file whose solutions seed the search", "", false);
+    parser.addOption("-cm", "--cost_model", "A cost model used to prune the partial solutions", "", false);
+    parser.addOption("-tc", "--train_cost_model", "Where to save a cost model trained on the results", "", false);
     // Search parameters.
     parser.addOption("-dp", "--depth", "The target tapping depth", 40.0, false);
     parser.addOption("-tm", "--time_max", "The maximum simulated time", 120.0, false);
@@ -267,6 +337,18 @@ void setup_option_parser(cmdlp::Parser &parser)
     parser.addToggle("-in", "--interactive", "Enable the interactive mode", false);
     // Search manager parameters.
     parser.addOption("-it", "--iterations", "The number of iterations for the search", 12U, false);
+    parser.addOption(
+        "-ml", "--memory_limit", "Memory for partial solutions (MB) before spilling them to disk (0 disables)", 0U,
+        false);
+    parser.addOption("-sd", "--spill_directory", "Where partial solutions are spilled (default: temp dir)", "", false);
+    parser.addOption(
+        "-ct", "--convergence_tolerance", "Stop when the hypervolume improves less than this between strides (0: off)",
+        0.0, false);
+    parser.addToggle(
+        "-cs", "--convergence_skip", "Once converged, skip to the finest stride instead of stopping", false);
+    parser.addToggle("-hc", "--counters", "Report the hardware counters of each search phase", false);
+    parser.addOption(
+        "-ro", "--rollout", "Partial solutions completed in their mode before each iteration (0: off)", 0U, false);
     // Gear factors parameters.
     parser.addOption("-gu", "--min_gear", "The minimum gear range", 5U, false);
     parser.addOption("-gl", "--max_gear", "The maximum gear range", 50U, false);
@@ -282,6 +364,7 @@ void setup_option_parser(cmdlp::Parser &parser)
             std::to_string(quire::log_level::critical),
         },
         std::to_string(quire::log_level::info));
+    parser.addToggle("-al", "--async_logging", "Forward the library logs from a background thread", false);
     // Enable plot.
     parser.addToggle("-pl", "--plot", "Plot the results", false);
 }
@@ -301,8 +384,21 @@ auto execute_in_discrete_mode(cmdlp::Parser &parser) -> int
     // Select the algorithm.
     auto algorithm = parser.getOption<unsigned>("-a");
 
-    // Get the number of iterations.
-    auto iterations = parser.getOption<unsigned>("--iterations");
+    // Search parameters.
+    flexman::search::SearchParameters search_parameters;
+    search_parameters.iterations            = parser.getOption<unsigned>("--iterations");
+    search_parameters.partial_memory_limit  =
+        static_cast<std::size_t>(parser.getOption<unsigned>("--memory_limit")) * 1024U * 1024U;
+    search_parameters.spill_directory       = parser.getOption<std::string>("--spill_directory");
+    search_parameters.convergence_tolerance = parser.getOption<double>("--convergence_tolerance");
+    search_parameters.convergence_action    = parser.getOption<bool>("--convergence_skip")
+                                                  ? flexman::search::ConvergenceAction::SkipToFinest
+                                                  : flexman::search::ConvergenceAction::Stop;
+    search_parameters.cost_model            = tapping::load_cost_model(parser.getOption<std::string>("--cost_model"));
+    search_parameters.rollout_samples       = parser.getOption<unsigned>("--rollout");
+    if (parser.getOption<bool>("--counters")) {
+        search_parameters.counters = std::make_shared<flexman::search::SearchCounters>();
+    }
 
     // Create the gear factors.
     const auto gear_factors = tapping::linspace<double>(
@@ -327,16 +423,19 @@ auto execute_in_discrete_mode(cmdlp::Parser &parser) -> int
     if (parser.getOption<unsigned>("--run") == run_search) {
         tapping::result_t results;
 
+        // Seed the search with the solutions of a prior run, if provided.
+        const auto seed = tapping::load_seed(search, modes, parser.getOption<std::string>("--seed"));
+
         qinfo(flexman::logging::app, "Searching...\n");
         if (algorithm == algorithm_heuristic) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::Heuristic>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         } else if (algorithm == algorithm_exhaustive) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::Exhaustive>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         } else if (algorithm == algorithm_single_machine) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::SingleMachine>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         }
 
         // Sort the results.
@@ -348,18 +447,31 @@ auto execute_in_discrete_mode(cmdlp::Parser &parser) -> int
         // Log the results.
         tapping::log_results(quire::info, results);
 
+        // Report the hardware counters of the search phases.
+        if (search_parameters.counters) {
+            flexman::search::log_counters(flexman::logging::app, quire::info, *search_parameters.counters);
+        }
+
         // Save results.
         tapping::save_results(search, results, parameters, modes, parser.getOption<std::string>("--output"));
 
+        // Train a cost model on the results, if requested.
+        if (!parser.getOption<std::string>("--train_cost_model").empty()) {
+            tapping::train_cost_model(search, modes, results, parser.getOption<std::string>("--train_cost_model"));
+        }
+
         // Apply PSO if requested.
         if (parser.getOption<bool>("--pso")) {
             qinfo(flexman::logging::app, "Running PSO...\n");
             flexman::pso::SolverParameters solver_params{
-                .num_particles  = parser.getOption<unsigned>("-pn"),
-                .max_iterations = parser.getOption<unsigned>("-pm"),
-                .inertia        = parser.getOption<double>("-pi"),
-                .cognitive      = parser.getOption<double>("-pc"),
-                .social         = parser.getOption<double>("-ps"),
+                .num_particles      = parser.getOption<unsigned>("-pn"),
+                .max_iterations     = parser.getOption<unsigned>("-pm"),
+                .inertia            = parser.getOption<double>("-pi"),
+                .cognitive          = parser.getOption<double>("-pc"),
+                .social             = parser.getOption<double>("-ps"),
+                .islands            = parser.getOption<unsigned>("-psi"),
+                .migration_interval = parser.getOption<unsigned>("-pmi"),
+                .migrants           = parser.getOption<unsigned>("-pmg"),
             };
             auto optimized = flexman::pso::optimize_result(&search, solver_params, modes, results);
             // Log the results.
@@ -413,12 +525,27 @@ auto execute_in_continuous_mode(cmdlp::Parser &parser) -> int
     search.threshold     = parser.getOption<double>("--threshold");
     search.timeout       = parser.getOption<double>("--timeout");
     search.interactive   = parser.getOption<bool>("--interactive");
+    search.integrator    = static_cast<tapping::integrator_option>(parser.getOption<unsigned>("--integrator"));
+    search.substeps      = std::max(1U, parser.getOption<unsigned>("--substeps"));
 
     // Select the algorithm.
     auto algorithm = parser.getOption<unsigned>("-a");
 
-    // Get the number of iterations.
-    auto iterations = parser.getOption<unsigned>("--iterations");
+    // Search parameters.
+    flexman::search::SearchParameters search_parameters;
+    search_parameters.iterations            = parser.getOption<unsigned>("--iterations");
+    search_parameters.partial_memory_limit  =
+        static_cast<std::size_t>(parser.getOption<unsigned>("--memory_limit")) * 1024U * 1024U;
+    search_parameters.spill_directory       = parser.getOption<std::string>("--spill_directory");
+    search_parameters.convergence_tolerance = parser.getOption<double>("--convergence_tolerance");
+    search_parameters.convergence_action    = parser.getOption<bool>("--convergence_skip")
+                                                  ? flexman::search::ConvergenceAction::SkipToFinest
+                                                  : flexman::search::ConvergenceAction::Stop;
+    search_parameters.cost_model            = tapping::load_cost_model(parser.getOption<std::string>("--cost_model"));
+    search_parameters.rollout_samples       = parser.getOption<unsigned>("--rollout");
+    if (parser.getOption<bool>("--counters")) {
+        search_parameters.counters = std::make_shared<flexman::search::SearchCounters>();
+    }
 
     // Create the gear factors.
     const auto gear_factors = tapping::linspace<double>(
@@ -443,16 +570,19 @@ auto execute_in_continuous_mode(cmdlp::Parser &parser) -> int
     if (parser.getOption<unsigned>("--run") == run_search) {
         tapping::result_t results;
 
+        // Seed the search with the solutions of a prior run, if provided.
+        const auto seed = tapping::load_seed(search, modes, parser.getOption<std::string>("--seed"));
+
         qinfo(flexman::logging::app, "Searching...\n");
         if (algorithm == algorithm_heuristic) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::Heuristic>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         } else if (algorithm == algorithm_exhaustive) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::Exhaustive>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         } else if (algorithm == algorithm_single_machine) {
             results = flexman::search::perform_search<flexman::search::SearchAlgorithm::SingleMachine>(
-                &search, modes, iterations);
+                &search, modes, search_parameters, seed);
         }
 
         // Sort the results.
@@ -464,18 +594,31 @@ auto execute_in_continuous_mode(cmdlp::Parser &parser) -> int
         // Log the results.
         tapping::log_results(quire::info, results);
 
+        // Report the hardware counters of the search phases.
+        if (search_parameters.counters) {
+            flexman::search::log_counters(flexman::logging::app, quire::info, *search_parameters.counters);
+        }
+
         // Save the results.
         tapping::save_results(search, results, parameters, modes, parser.getOption<std::string>("--output"));
 
+        // Train a cost model on the results, if requested.
+        if (!parser.getOption<std::string>("--train_cost_model").empty()) {
+            tapping::train_cost_model(search, modes, results, parser.getOption<std::string>("--train_cost_model"));
+        }
+
         // Apply PSO if requested.
         if (parser.getOption<bool>("--pso")) {
             qinfo(flexman::logging::app, "Running PSO...\n");
             flexman::pso::SolverParameters solver_params{
-                .num_particles  = parser.getOption<unsigned>("-pn"),
-                .max_iterations = parser.getOption<unsigned>("-pm"),
-                .inertia        = parser.getOption<double>("-pi"),
-                .cognitive      = parser.getOption<double>("-pc"),
-                .social         = parser.getOption<double>("-ps"),
+                .num_particles      = parser.getOption<unsigned>("-pn"),
+                .max_iterations     = parser.getOption<unsigned>("-pm"),
+                .inertia            = parser.getOption<double>("-pi"),
+                .cognitive          = parser.getOption<double>("-pc"),
+                .social             = parser.getOption<double>("-ps"),
+                .islands            = parser.getOption<unsigned>("-psi"),
+                .migration_interval = parser.getOption<unsigned>("-pmi"),
+                .migrants           = parser.getOption<unsigned>("-pmg"),
             };
             auto optimized = flexman::pso::optimize_result(&search, solver_params, modes, results);
             // Log the results.
@@ -499,13 +642,43 @@ auto execute_in_continuous_mode(cmdlp::Parser &parser) -> int
         // Number of simulation steps.
         auto simulation_steps = static_cast<unsigned>(search.time_max / search.time_delta);
 
+        // The Parareal simulation, with a coarse propagator taking a single
+        // Rosenbrock step every ten time deltas.
+        const auto slices = parser.getOption<unsigned>("--parareal");
+        auto coarse       = search;
+        coarse.integrator = tapping::integrator_rosenbrock;
+        coarse.substeps   = 1;
+        coarse.time_delta = search.time_delta * 10;
+        flexman::parallel::Executor executor(std::max(1U, slices));
+
         // Run the simulation.
         qinfo(flexman::logging::app, "Simulating...\n");
         for (const auto &mode : modes) {
+            if (slices == 0) {
+                simulations.emplace_back(tapping::simulation_t{
+                    .data = flexman::simulation::simulate_single_mode(&search, mode, simulation_steps),
+                    .name = "Mode " + std::to_string(mode.id),
+                });
+                continue;
+            }
+            flexman::simulation::PararealReport report;
             simulations.emplace_back(tapping::simulation_t{
-                .data = flexman::simulation::simulate_single_mode(&search, mode, simulation_steps),
+                .data = flexman::simulation::simulate_single_mode_parareal(
+                    &search, &coarse, mode, simulation_steps, {.slices = slices}, executor, &report),
                 .name = "Mode " + std::to_string(mode.id),
             });
+            qinfo(
+                flexman::logging::app, "Mode %2u: Parareal took %u iterations over %u slices (converged: %s).\n",
+                mode.id, report.iterations, report.slices, report.converged ? "yes" : "no");
+            if (parser.getOption<bool>("--parareal_verify")) {
+                const auto error = flexman::simulation::compare_simulations(
+                    flexman::simulation::simulate_single_mode(&search, mode, simulation_steps),
+                    simulations.back().data);
+                qinfo(
+                    flexman::logging::app,
+                    "Mode %2u: error against the serial simulation, state %g, distance %g, steps %d.\n", mode.id,
+                    error.state, error.distance, error.steps);
+            }
         }
 
         // Plot the results.
@@ -555,11 +728,19 @@ auto main(int argc, char *argv[]) -> int
             {quire::option_t::time, quire::option_t::header, quire::option_t::level, quire::option_t::location});
     }
 
-    if (parser.getOption<unsigned>("-m") == tapping::mode_discrete) {
-        return tapping::execute_in_discrete_mode(parser);
+    // Forward the library logs asynchronously, if requested.
+    if (parser.getOption<bool>("--async_logging")) {
+        flexman::logging::async_sink().start();
     }
-    if (parser.getOption<unsigned>("-m") == tapping::mode_continuous) {
-        return tapping::execute_in_continuous_mode(parser);
+
+    int status = 0;
+    if (parser.getOption<unsigned>("-m") == tapping::mode_discrete) {
+        status = tapping::execute_in_discrete_mode(parser);
+    } else if (parser.getOption<unsigned>("-m") == tapping::mode_continuous) {
+        status = tapping::execute_in_continuous_mode(parser);
     }
-    return 0;
+
+    // Forward the pending logs.
+    flexman::logging::async_sink().stop();
+    return status;
 }
@@ -25,6 +25,10 @@
 
 #include "builder.hpp"
 
+#include <flexman/integration/block.hpp>
+#include <flexman/integration/rk4.hpp>
+#include <flexman/integration/rosenbrock.hpp>
+
 #include <numint/detail/observer.hpp>
 #include <numint/solver.hpp>
 #include <numint/stepper/stepper_rk4.hpp>
@@ -98,27 +102,49 @@ public:
     }
 };
 
+/// @brief The integrators available to the continuous search.
+enum integrator_option : unsigned char {
+    integrator_rk4,
+    integrator_rosenbrock,
+};
+
 class continuous_search_t : public flexman::core::Manager<state_t, continous_mode_t, resources_t>
 {
 public:
     continuous_search_t() = default;
 
+    /// @brief The integrator of the dynamics.
+    integrator_option integrator = integrator_rk4;
+    /// @brief The number of integration steps per time delta.
+    unsigned substeps = 100;
+
     void updated_solution(solution_t &solution, const continous_mode_t &mode) const override
     {
-        // Update the state.
-        numint::stepper_rk4<state_t, double> solver;
-        numint::detail::Observer<state_t, double> observer;
         // Compute the step_size.
-        double step_size = time_delta / 100;
-        // Perform integration.
-        numint::integrate_fixed(
-            solver, observer,
-            [&](const state_t &x, state_t &dxdt, double) {
-                // Advance system state.
-                dxdt = fsmlib::multiply(mode.system.A, x) + fsmlib::multiply(mode.system.B, mode.input);
-            },
-            solution.state, solution.resources.time, solution.resources.time + time_delta, step_size,
-            [&](const state_t &x) { return (target_state[2] - x[2]) < threshold; });
+        double step_size = time_delta / substeps;
+        if (integrator == integrator_rosenbrock) {
+            // Update the state, with the same integrator of the batched advance.
+            flexman::integration::StateBlock<double, n_states> block(1);
+            block.load(0, solution.state);
+            const auto derivative = flexman::integration::LinearDerivative<double, n_states>::from(
+                mode.system.A, fsmlib::multiply(mode.system.B, mode.input));
+            flexman::integration::Rosenbrock2<double, n_states> solver(step_size);
+            solver.integrate(derivative, block, 0.0, time_delta, this->stop_condition());
+            block.store(0, solution.state);
+        } else {
+            // Update the state.
+            numint::stepper_rk4<state_t, double> solver;
+            numint::detail::Observer<state_t, double> observer;
+            // Perform integration.
+            numint::integrate_fixed(
+                solver, observer,
+                [&](const state_t &x, state_t &dxdt, double) {
+                    // Advance system state.
+                    dxdt = fsmlib::multiply(mode.system.A, x) + fsmlib::multiply(mode.system.B, mode.input);
+                },
+                solution.state, solution.resources.time, solution.resources.time + time_delta, step_size,
+                [&](const state_t &x) { return (target_state[2] - x[2]) < threshold; });
+        }
         // Update the distance.
         solution.distance = this->distance(solution);
         // Update energy.
@@ -127,6 +153,61 @@ public:
         solution.resources.time += time_delta;
     }
 
+    bool supports_batched_advance() const override { return true; }
+
+    void advance_solutions_batched(
+        std::vector<solution_t> &solutions,
+        const continous_mode_t &mode,
+        unsigned steps,
+        std::vector<unsigned> &advanced) const override
+    {
+        const std::size_t lanes = solutions.size();
+        const std::size_t first = advanced.size();
+        advanced.resize(first + lanes, steps);
+        // Load the states, one lane each.
+        flexman::integration::StateBlock<double, n_states> block(lanes);
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            block.load(lane, solutions[lane].state);
+        }
+        // The same dynamics of `updated_solution`, for all the states together.
+        const auto derivative = flexman::integration::LinearDerivative<double, n_states>::from(
+            mode.system.A, fsmlib::multiply(mode.system.B, mode.input));
+        const auto stop = this->stop_condition();
+        flexman::integration::FixedStepRk4<double, n_states> rk4(time_delta / substeps);
+        flexman::integration::Rosenbrock2<double, n_states> rosenbrock(time_delta / substeps);
+        // Advance step by step, a lane stops right before the step that completes it.
+        auto previous = block;
+        for (unsigned step = 0; (step < steps) && (block.active_lanes() > 0); ++step) {
+            previous = block;
+            if (integrator == integrator_rosenbrock) {
+                rosenbrock.integrate(derivative, block, 0.0, time_delta, stop);
+            } else {
+                rk4.integrate(derivative, block, 0.0, time_delta, stop);
+            }
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                if (!previous.is_active(lane)) {
+                    continue;
+                }
+                if (!block.is_active(lane)) {
+                    advanced[first + lane] = step;
+                    previous.store(lane, solutions[lane].state);
+                    continue;
+                }
+                // Update energy.
+                solutions[lane].resources.energy += block(1, lane) * mode.input[0] * time_delta;
+                // Update time.
+                solutions[lane].resources.time += time_delta;
+            }
+        }
+        // Store the states of the lanes that did not stop.
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            if (advanced[first + lane] == steps) {
+                block.store(lane, solutions[lane].state);
+            }
+            solutions[lane].distance = this->distance(solutions[lane]);
+        }
+    }
+
     double distance(const solution_t &solution) const override { return target_state[2] - solution.state[2]; }
 
     bool is_complete(const solution_t &solution) const override { return this->distance(solution) < threshold; }
@@ -174,6 +255,15 @@ public:
         }
         return interpolated_state;
     }
+
+private:
+    /// @brief The stop condition of the integrators, a lane stops once it reaches the target.
+    auto stop_condition() const
+    {
+        return [this](const flexman::integration::StateBlock<double, n_states> &x, std::size_t lane) {
+            return (target_state[2] - x(2, lane)) < threshold;
+        };
+    }
 };
 
 } // namespace tapping
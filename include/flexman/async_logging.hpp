@@ -0,0 +1,387 @@
+/// @file async_logging.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines an asynchronous sink for the Flexman loggers.
+///
+/// @details
+/// This file provides the `AsyncSink` class, which decouples the threads that
+/// produce log messages from the output stream. Each producing thread formats
+/// its messages into its own single-producer single-consumer ring buffer, and
+/// a background flusher thread forwards them to the Quire loggers. Producers
+/// never block: when a ring buffer is full, the message is dropped and counted.
+///
+/// The sink must be stopped before calling `fork`, since the child process
+/// would not inherit the flusher thread.
+///
+/// The `qdebug_async`, `qinfo_async` and `qwarning_async` macros behave like
+/// their Quire counterparts when the sink is not running, hence, the hot paths
+/// of the library can use them unconditionally. Messages of a single thread are
+/// forwarded in order, while messages of different threads may interleave.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flexman/logging.hpp"
+
+namespace flexman
+{
+namespace logging
+{
+
+class AsyncSink;
+
+/// @brief Returns the asynchronous sink shared by the library.
+/// @return the asynchronous sink.
+inline auto async_sink() -> AsyncSink &;
+
+/// @brief An asynchronous sink for the loggers, with per-thread ring buffers
+/// and a background flusher.
+///
+/// @details The ring buffer of a thread is stored in a `thread_local`, hence,
+/// there is a single sink per process, reachable through `async_sink()`.
+class AsyncSink
+{
+public:
+    /// @brief The maximum length of a message, longer messages are truncated.
+    static constexpr std::size_t message_size = 256;
+    /// @brief The number of messages each ring buffer can hold.
+    static constexpr std::size_t ring_capacity = 1024;
+
+    static_assert((ring_capacity & (ring_capacity - 1)) == 0, "ring capacity must be a power of two");
+
+    /// @brief Copy constructor (deleted, the sink owns the flusher thread).
+    AsyncSink(const AsyncSink &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, the sink owns the flusher thread).
+    auto operator=(const AsyncSink &other) -> AsyncSink & = delete;
+
+    /// @brief Move constructor (deleted, producers refer to the sink by address).
+    AsyncSink(AsyncSink &&other) = delete;
+
+    /// @brief Move assignment operator (deleted, producers refer to the sink by address).
+    auto operator=(AsyncSink &&other) -> AsyncSink & = delete;
+
+    /// @brief Destructor, stops the flusher.
+    ///
+    /// @details The sink is destroyed with the static objects, when the loggers
+    /// may be gone already, hence, the pending messages are not forwarded and
+    /// the dropped ones are not reported. Call `stop` before leaving `main`.
+    ~AsyncSink()
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        this->halt();
+    }
+
+    /// @brief Starts the background flusher.
+    ///
+    /// @param interval how long the flusher sleeps when there is nothing to forward.
+    void start(std::chrono::microseconds interval = std::chrono::microseconds(1000))
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if (active.load(std::memory_order_acquire)) {
+            return;
+        }
+        stopping.store(false, std::memory_order_relaxed);
+        flusher = std::thread([this, interval]() {
+            while (!stopping.load(std::memory_order_acquire)) {
+                if (this->drain() == 0) {
+                    std::this_thread::sleep_for(interval);
+                }
+            }
+        });
+        active.store(true, std::memory_order_release);
+    }
+
+    /// @brief Stops the background flusher, after forwarding the pending messages.
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if (!this->halt()) {
+            return;
+        }
+        this->drain();
+        // Report the dropped messages, and reset their count.
+        std::lock_guard<std::mutex> rings_lock(rings_mutex);
+        std::size_t count = std::exchange(released_dropped, 0);
+        for (auto &ring : rings) {
+            count += ring->dropped.exchange(0, std::memory_order_relaxed);
+        }
+        if (count > 0) {
+            qwarning(logging::common, "The asynchronous sink dropped %u messages.\n", count);
+        }
+    }
+
+    /// @brief Checks if the background flusher is running.
+    /// @return true if messages are forwarded asynchronously, false otherwise.
+    auto running() const noexcept -> bool { return active.load(std::memory_order_acquire); }
+
+    /// @brief Waits until all the messages queued so far have been forwarded.
+    void flush()
+    {
+        if (!this->running()) {
+            this->drain();
+            return;
+        }
+        while (this->pending()) {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Returns the number of messages dropped because a ring buffer was
+    /// full, since the sink was last started.
+    /// @return the number of dropped messages.
+    auto dropped() const -> std::size_t
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        std::size_t total = released_dropped;
+        for (const auto &ring : rings) {
+            total += ring->dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// @brief Queues a message, without blocking, if the flusher is running.
+    ///
+    /// @param logger the logger the message is forwarded to.
+    /// @param level the level of the message.
+    /// @param format the printf-like format of the message.
+    /// @param args the arguments of the message.
+    ///
+    /// @return true if the message was queued, or dropped because the ring
+    /// buffer is full, false if the flusher is not running.
+    template <typename... Args>
+    auto push(quire::logger_t &logger, quire::log_level level, const char *format, Args &&...args) -> bool
+    {
+        // Announce the producer before checking the flusher, so that `stop`
+        // waits for the message before its last drain.
+        producer_guard_t guard(producers);
+        if (!active.load(std::memory_order_seq_cst)) {
+            return false;
+        }
+        ring_t &ring        = this->local_ring();
+        const auto head     = ring.head.load(std::memory_order_relaxed);
+        const auto tail     = ring.tail.load(std::memory_order_acquire);
+        // If the ring is full, drop the message.
+        if (head - tail == ring_capacity) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        message_t &message = ring.messages[head & (ring_capacity - 1)];
+        message.logger     = &logger;
+        message.level      = level;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+        std::snprintf(message.text.data(), message_size, format, std::forward<Args>(args)...);
+#pragma GCC diagnostic pop
+        ring.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    /// @brief The sink is only constructed by `async_sink()`.
+    friend auto async_sink() -> AsyncSink &;
+
+    /// @brief Constructor.
+    AsyncSink() = default;
+
+    /// @brief A queued message.
+    struct message_t {
+        /// @brief The logger the message is forwarded to.
+        quire::logger_t *logger{nullptr};
+        /// @brief The level of the message.
+        quire::log_level level{quire::info};
+        /// @brief The formatted message.
+        std::array<char, message_size> text{};
+    };
+
+    /// @brief A single-producer single-consumer ring buffer.
+    struct ring_t {
+        /// @brief The messages.
+        std::array<message_t, ring_capacity> messages{};
+        /// @brief The number of messages written by the producer.
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        /// @brief The number of messages read by the flusher.
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+        /// @brief The number of dropped messages.
+        std::atomic<std::size_t> dropped{0};
+    };
+
+    /// @brief Counts a producer while it is alive.
+    struct producer_guard_t {
+        /// @brief Constructor, counts the producer.
+        /// @param _producers the number of producers.
+        explicit producer_guard_t(std::atomic<std::size_t> &_producers)
+            : producers(_producers)
+        {
+            producers.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        producer_guard_t(const producer_guard_t &)                     = delete;
+        auto operator=(const producer_guard_t &) -> producer_guard_t & = delete;
+
+        /// @brief Destructor, releases the producer.
+        ~producer_guard_t() { producers.fetch_sub(1, std::memory_order_release); }
+
+        /// @brief The number of producers.
+        std::atomic<std::size_t> &producers;
+    };
+
+    /// @brief Stops the flusher, once the producers that saw it running have
+    /// queued their messages. The caller holds `control_mutex`.
+    /// @return true if the flusher was running, false otherwise.
+    auto halt() -> bool
+    {
+        if (!active.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // From now on, producers log synchronously.
+        active.store(false, std::memory_order_seq_cst);
+        while (producers.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        stopping.store(true, std::memory_order_release);
+        flusher.join();
+        return true;
+    }
+
+    /// @brief Returns the ring buffer of the calling thread, registering it on first use.
+    /// @return the ring buffer of the calling thread.
+    auto local_ring() -> ring_t &
+    {
+        thread_local std::shared_ptr<ring_t> ring;
+        if (!ring) {
+            ring = std::make_shared<ring_t>();
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.emplace_back(ring);
+        }
+        return *ring;
+    }
+
+    /// @brief Forwards the queued messages to their loggers.
+    /// @return the number of forwarded messages.
+    auto drain() -> std::size_t
+    {
+        // Each ring has a single consumer, hence, the callers are serialized.
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+        // Forward the messages outside of the lock, so that the loggers do not
+        // stall the threads registering their ring.
+        std::vector<std::shared_ptr<ring_t>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            snapshot = rings;
+        }
+        std::size_t forwarded = 0;
+        for (auto &ring : snapshot) {
+            const auto head = ring->head.load(std::memory_order_acquire);
+            auto tail       = ring->tail.load(std::memory_order_relaxed);
+            for (; tail != head; ++tail) {
+                const message_t &message = ring->messages[tail & (ring_capacity - 1)];
+                qlog(*message.logger, message.level, "%s", message.text.data());
+                ++forwarded;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+        snapshot.clear();
+        // Release the rings of the threads that have terminated, once they
+        // have been drained.
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        rings.erase(
+            std::remove_if(
+                rings.begin(), rings.end(),
+                [this](const std::shared_ptr<ring_t> &ring) {
+                    if (ring.use_count() > 1) {
+                        return false;
+                    }
+                    if (ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_relaxed)) {
+                        return false;
+                    }
+                    released_dropped += ring->dropped.load(std::memory_order_relaxed);
+                    return true;
+                }),
+            rings.end());
+        return forwarded;
+    }
+
+    /// @brief Checks if there are queued messages.
+    /// @return true if some message has not been forwarded yet.
+    auto pending() const -> bool
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        return std::any_of(rings.begin(), rings.end(), [](const std::shared_ptr<ring_t> &ring) {
+            return ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_acquire);
+        });
+    }
+
+    /// @brief Protects the list of ring buffers.
+    mutable std::mutex rings_mutex;
+    /// @brief Serializes the consumers of the ring buffers.
+    std::mutex drain_mutex;
+    /// @brief Serializes start and stop.
+    std::mutex control_mutex;
+    /// @brief The ring buffers of the producing threads.
+    std::vector<std::shared_ptr<ring_t>> rings;
+    /// @brief The messages dropped by the rings that have been released.
+    std::size_t released_dropped{0};
+    /// @brief The background flusher.
+    std::thread flusher;
+    /// @brief True while the flusher is running.
+    std::atomic<bool> active{false};
+    /// @brief Asks the flusher to terminate.
+    std::atomic<bool> stopping{false};
+    /// @brief The number of producers between the check of the flusher and
+    /// the end of their message.
+    std::atomic<std::size_t> producers{0};
+};
+
+inline auto async_sink() -> AsyncSink &
+{
+    static AsyncSink sink;
+    return sink;
+}
+
+/// @brief Logs a message through the asynchronous sink, if running, or
+/// synchronously otherwise.
+///
+/// @param logger the logger.
+/// @param level the level of the message.
+/// @param format the printf-like format of the message.
+/// @param args the arguments of the message.
+template <typename... Args>
+inline void async_log(quire::logger_t &logger, quire::log_level level, const char *format, Args &&...args)
+{
+    // Skip the formatting if the message would be filtered anyway.
+    if (level < logger.get_log_level()) {
+        return;
+    }
+    if (!async_sink().push(logger, level, format, args...)) {
+        qlog(logger, level, format, std::forward<Args>(args)...);
+    }
+}
+
+} // namespace logging
+} // namespace flexman
+
+/// @brief Logs a debug message through the asynchronous sink.
+#define qdebug_async(logger, ...) flexman::logging::async_log(logger, quire::debug, __VA_ARGS__)
+/// @brief Logs an info message through the asynchronous sink.
+#define qinfo_async(logger, ...) flexman::logging::async_log(logger, quire::info, __VA_ARGS__)
+/// @brief Logs a warning message through the asynchronous sink.
+#define qwarning_async(logger, ...) flexman::logging::async_log(logger, quire::warning, __VA_ARGS__)
@@ -0,0 +1,78 @@
+/// @file fingerprint.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Describes values by their content, to fingerprint search requests.
+///
+/// @details
+/// This file provides the `append_value` function, which appends a
+/// description of a value to a fingerprint, such that two values have the
+/// same description only if they are equal (see `SearchCoordinator`). The raw
+/// bytes of a value are used only when they have unique object
+/// representations, i.e., no padding and no two representations of the same
+/// value. Otherwise:
+/// - Floating point values are normalized first, so that 0.0 and -0.0 are
+///   described alike.
+/// - Ranges, e.g., vectors and matrices, are described element by element.
+/// - Structures are described through an `append_fields` function, found by
+///   argument-dependent lookup, which describes their fields one by one (see
+///   `flexman::linear::System`).
+///
+/// Values that cannot be described are reported as such, so that the caller
+/// can fall back to their address.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+namespace flexman
+{
+namespace core
+{
+
+/// @brief Appends a description of a value to a fingerprint.
+///
+/// @tparam T The type of the value.
+///
+/// @param key the fingerprint.
+/// @param value the value.
+///
+/// @return True if the value was described, false if it cannot be, in which
+/// case the fingerprint may hold a part of its description.
+template <typename T>
+inline auto append_value(std::string &key, const T &value) -> bool
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        // Adding zero turns -0.0 into 0.0, and leaves any other value unchanged.
+        const T normalized = value + T(0);
+        key.append(reinterpret_cast<const char *>(&normalized), sizeof(T));
+        return true;
+    } else if constexpr (std::has_unique_object_representations_v<T>) {
+        key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        return true;
+    } else if constexpr (std::ranges::sized_range<const T>) {
+        const auto size = static_cast<std::size_t>(std::ranges::size(value));
+        key.append(reinterpret_cast<const char *>(&size), sizeof(size));
+        for (const auto &element : value) {
+            if (!flexman::core::append_value(key, element)) {
+                return false;
+            }
+        }
+        return true;
+    } else if constexpr (requires { { append_fields(key, value) } -> std::same_as<bool>; }) {
+        return append_fields(key, value);
+    } else {
+        return false;
+    }
+}
+
+} // namespace core
+} // namespace flexman
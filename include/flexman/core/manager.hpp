@@ -14,6 +14,12 @@
 /// - Measuring the distance between a solution and the target.
 /// - Comparing solutions based on strict and probabilistic criteria.
 /// - Interpolating states and resources for finer control over transitions.
+/// - Optionally, advancing a solution by several steps at once, also under
+///   all the modes together, advancing many solutions under the same mode
+///   together, and locating the completion point analytically, for managers
+///   that can do it faster than the step-by-step simulation.
+/// - Optionally, describing the settings of a derived manager, so that
+///   identical search requests can be recognized.
 ///
 /// The `Manager` class is designed to be extended with specific search
 /// strategies, enabling flexible and customizable search management.
@@ -25,6 +31,11 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <timelib/timespec.hpp>
 
 #include "flexman/core/solution.hpp"
@@ -162,6 +173,132 @@ public:
     ///
     /// @return Interpolated Resources instance.
     virtual auto interpolate_state(const State &s0, const State &s1, double rel) const -> State = 0;
+
+    /// @brief Checks if the manager provides a faster `advance_solution` than
+    /// the step-by-step simulation.
+    ///
+    /// @return True if the simulation should use `advance_solution`, false otherwise.
+    virtual auto supports_fast_advance() const -> bool { return false; }
+
+    /// @brief Advances the given solution by up to the given number of steps
+    /// of the same mode, stopping right before the step that completes it.
+    ///
+    /// @details The sequence of the solution is left untouched, the caller is
+    /// responsible for recording the advanced steps.
+    ///
+    /// @param solution The solution to be advanced.
+    /// @param mode The mode used for advancing the solution.
+    /// @param steps The maximum number of steps.
+    ///
+    /// @return The number of steps actually advanced. If it is lower than
+    /// `steps`, the next step completes the solution.
+    virtual auto advance_solution(
+        flexman::core::Solution<State, Resources> &solution,
+        const Mode &mode,
+        unsigned steps) const -> unsigned
+    {
+        for (unsigned step = 0; step < steps; ++step) {
+            auto next = solution;
+            this->updated_solution(next, mode);
+            if (this->is_complete(next)) {
+                return step;
+            }
+            solution = std::move(next);
+        }
+        return steps;
+    }
+
+    /// @brief Checks if the manager provides a faster `advance_solution_stacked`
+    /// than advancing the solution under each mode separately.
+    ///
+    /// @return True if the extension of the solutions should use
+    /// `advance_solution_stacked`, false otherwise.
+    virtual auto supports_stacked_advance() const -> bool { return false; }
+
+    /// @brief Advances a copy of the given solution under each of the given
+    /// modes, by up to the given number of steps, with the same semantics of
+    /// `advance_solution`.
+    ///
+    /// @param solution The solution to be advanced.
+    /// @param modes The modes used for advancing the solution.
+    /// @param steps The maximum number of steps.
+    /// @param children Where the advanced copies are appended, one per mode, in
+    /// the order of the modes.
+    /// @param advanced Where the number of steps advanced by each copy is appended.
+    virtual void advance_solution_stacked(
+        const flexman::core::Solution<State, Resources> &solution,
+        const std::vector<Mode> &modes,
+        unsigned steps,
+        std::vector<flexman::core::Solution<State, Resources>> &children,
+        std::vector<unsigned> &advanced) const
+    {
+        for (const auto &mode : modes) {
+            children.push_back(solution);
+            advanced.push_back(this->advance_solution(children.back(), mode, steps));
+        }
+    }
+
+    /// @brief Checks if the manager provides a faster `advance_solutions_batched`
+    /// than advancing each solution separately.
+    ///
+    /// @return True if the extension of the solutions should use
+    /// `advance_solutions_batched`, false otherwise.
+    virtual auto supports_batched_advance() const -> bool { return false; }
+
+    /// @brief Advances each of the given solutions under the same mode, by up
+    /// to the given number of steps, with the same semantics of
+    /// `advance_solution`.
+    ///
+    /// @param solutions The solutions to be advanced, in place.
+    /// @param mode The mode used for advancing the solutions.
+    /// @param steps The maximum number of steps.
+    /// @param advanced Where the number of steps advanced by each solution is
+    /// appended, in the order of the solutions.
+    virtual void advance_solutions_batched(
+        std::vector<flexman::core::Solution<State, Resources>> &solutions,
+        const Mode &mode,
+        unsigned steps,
+        std::vector<unsigned> &advanced) const
+    {
+        for (auto &solution : solutions) {
+            advanced.push_back(this->advance_solution(solution, mode, steps));
+        }
+    }
+
+    /// @brief Locates the point, between two consecutive solutions, where the
+    /// solution completes.
+    ///
+    /// @param previous The solution before the step, which is not complete.
+    /// @param current The solution after the step, which is complete.
+    ///
+    /// @return The solution at the completion point, or nothing if the
+    /// manager cannot locate it analytically, in which case it is searched by
+    /// interpolation.
+    virtual auto crossing_solution(
+        const flexman::core::Solution<State, Resources> &previous,
+        const flexman::core::Solution<State, Resources> &current) const
+        -> std::optional<flexman::core::Solution<State, Resources>>
+    {
+        (void)previous;
+        (void)current;
+        return std::nullopt;
+    }
+
+    /// @brief Appends the settings of the derived manager, i.e., all the fields
+    /// that change the outcome of a search besides those of this class, to the
+    /// fingerprint of a search request (see `SearchCoordinator`), e.g., with
+    /// `flexman::core::append_value`.
+    ///
+    /// @param key The fingerprint, to which the settings are appended.
+    ///
+    /// @return True if the settings were appended, false if the manager cannot
+    /// describe them, in which case two requests are only considered identical
+    /// when they use the same manager instance.
+    virtual auto append_settings(std::string &key) const -> bool
+    {
+        (void)key;
+        return false;
+    }
 };
 
 } // namespace core
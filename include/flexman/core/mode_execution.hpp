@@ -45,6 +45,13 @@ struct ModeExecution {
     /// @brief Number of consecutive executions for the mode.
     std::size_t times;
 
+    /// @brief Constructs an empty ModeExecution instance, e.g., before deserializing it.
+    ModeExecution()
+        : ModeExecution(0, 0)
+    {
+        // Nothing to do.
+    }
+
     /// @brief Constructs a ModeExecution instance.
     ///
     /// @param _mode The identifier of the mode.
@@ -97,14 +104,21 @@ namespace detail
 ///
 /// @param mode The mode to execute.
 /// @param sequence The sequence of mode executions to update.
-inline void add_mode_execution_to_sequence(flexman::core::ModeId mode, std::vector<ModeExecution> &sequence)
+/// @param times The number of consecutive executions to add.
+inline void add_mode_execution_to_sequence(
+    flexman::core::ModeId mode,
+    std::vector<ModeExecution> &sequence,
+    std::size_t times = 1)
 {
+    if (times == 0) {
+        return;
+    }
     if (sequence.empty() || (sequence.back().mode != mode)) {
         // Add new mode to the sequence if it's empty or different from the last.
-        sequence.emplace_back(mode, 1);
+        sequence.emplace_back(mode, times);
     } else {
         // Increment the count if it's the same as the last mode.
-        sequence.back().times++;
+        sequence.back().times += times;
     }
 }
 } // namespace detail
@@ -0,0 +1,363 @@
+/// @file packed.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines trivially copyable layouts of modes and solutions.
+///
+/// @details
+/// A `Mode` declares a virtual destructor, and a `Solution` owns its sequence
+/// through a `std::vector`, hence, neither can be copied with `memcpy` or
+/// written to a flat buffer as is. This file provides their non-polymorphic,
+/// standard-layout counterparts, for applications that need to store or
+/// transfer modes and solutions as plain bytes:
+/// - `PackedMode`, which holds the identifier, the system, and the input.
+/// - `PackedSequence`, a sequence of mode executions with a fixed capacity,
+///   stored inline.
+/// - `PackedSolution`, which holds the state, the resources, the distance, and
+///   a `PackedSequence`.
+///
+/// They are trivially copyable and standard-layout whenever the system, the
+/// input, the state, and the resources are, which is checked by
+/// `is_packable_v`. The `pack` and `unpack` functions convert to and from the
+/// owning types, and `pack_solutions` converts a whole set at once. The
+/// library itself does not use them: the shared archive of the sharded search
+/// stores only the state, the resources, and the distance of a solution (see
+/// `SharedArchive`), and the fingerprints of the search requests describe the
+/// modes by content (see `fingerprint.hpp`).
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "flexman/core/mode.hpp"
+#include "flexman/core/mode_execution.hpp"
+#include "flexman/core/solution.hpp"
+
+namespace flexman
+{
+namespace core
+{
+
+/// @brief Checks if the values of the given types can be stored in a packed
+/// layout, i.e., if they are trivially copyable and standard-layout.
+///
+/// @tparam Types The types to check.
+template <typename... Types>
+inline constexpr bool is_packable_v =
+    ((std::is_trivially_copyable_v<Types> && std::is_standard_layout_v<Types>) && ...);
+
+/// @brief A mode without virtual functions, with the same content of `Mode`.
+///
+/// @tparam System The type defining the system's dynamics.
+/// @tparam Input The type defining the system's input.
+template <typename System, typename Input>
+struct PackedMode {
+    static_assert(is_packable_v<System, Input>, "the system and the input must be trivially copyable");
+
+    /// @brief Unique identifier for the mode.
+    std::size_t id{};
+    /// @brief The system's dynamic representation (e.g., state-space matrices).
+    System system;
+    /// @brief Fixed input for the mode.
+    Input input;
+};
+
+/// @brief A sequence of mode executions with a fixed capacity, stored inline.
+///
+/// @tparam Capacity The maximum number of mode executions.
+template <std::size_t Capacity>
+struct PackedSequence {
+    static_assert(Capacity > 0, "the capacity must be greater than 0");
+
+    /// @brief The number of mode executions in use.
+    std::size_t length{};
+    /// @brief The mode executions, only the first `length` are valid.
+    std::array<ModeExecution, Capacity> executions;
+
+    /// @brief Returns the number of mode executions.
+    ///
+    /// @return The number of mode executions.
+    auto size() const noexcept -> std::size_t
+    {
+        return length;
+    }
+
+    /// @brief Checks if the sequence is empty.
+    ///
+    /// @return True if there are no mode executions, false otherwise.
+    auto empty() const noexcept -> bool
+    {
+        return length == 0;
+    }
+
+    /// @brief Returns the maximum number of mode executions.
+    ///
+    /// @return The capacity.
+    static constexpr auto capacity() noexcept -> std::size_t
+    {
+        return Capacity;
+    }
+
+    /// @brief Returns the first mode execution.
+    ///
+    /// @return An iterator to the first mode execution.
+    auto begin() const noexcept -> const ModeExecution *
+    {
+        return executions.data();
+    }
+
+    /// @brief Returns the end of the mode executions.
+    ///
+    /// @return An iterator past the last mode execution.
+    auto end() const noexcept -> const ModeExecution *
+    {
+        return executions.data() + length;
+    }
+
+    /// @brief Returns the last mode execution, the sequence must not be empty.
+    ///
+    /// @return The last mode execution.
+    auto back() const noexcept -> const ModeExecution &
+    {
+        return executions[length - 1];
+    }
+
+    /// @brief Adds a mode to the sequence or updates the count of the last
+    /// mode if it matches, as `detail::add_mode_execution_to_sequence` does.
+    ///
+    /// @param mode The mode to execute.
+    /// @param times The number of consecutive executions to add.
+    ///
+    /// @return False if a new mode execution does not fit, in which case the
+    /// sequence is left unchanged, true otherwise.
+    auto push(ModeId mode, std::size_t times = 1) noexcept -> bool
+    {
+        if (times == 0) {
+            return true;
+        }
+        if ((length > 0) && (executions[length - 1].mode == mode)) {
+            executions[length - 1].times += times;
+            return true;
+        }
+        if (length == Capacity) {
+            return false;
+        }
+        executions[length++] = ModeExecution(mode, times);
+        return true;
+    }
+
+    /// @brief Compares two sequences for equality.
+    ///
+    /// @param lhs The left-hand side sequence.
+    /// @param rhs The right-hand side sequence.
+    ///
+    /// @return True if both hold the same mode executions, false otherwise.
+    friend auto operator==(const PackedSequence &lhs, const PackedSequence &rhs) noexcept -> bool
+    {
+        if (lhs.length != rhs.length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < lhs.length; ++i) {
+            if (lhs.executions[i] != rhs.executions[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// @brief A solution whose sequence is stored inline, with a fixed capacity.
+///
+/// @details The state, the resources, and the distance come first, hence, the
+/// fields read by the dominance filters are contiguous.
+///
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+/// @tparam Capacity The maximum number of mode executions.
+template <typename State, typename Resources, std::size_t Capacity>
+struct PackedSolution {
+    static_assert(is_packable_v<State, Resources>, "the state and the resources must be trivially copyable");
+
+    /// @brief The current state (x).
+    State state;
+    /// @brief Resources accumulated so far.
+    Resources resources;
+    /// @brief Distance from the target state.
+    double distance{};
+    /// @brief The sequence of mode executions.
+    PackedSequence<Capacity> sequence;
+};
+
+/// @brief Packs a mode.
+///
+/// @tparam System The type defining the system's dynamics.
+/// @tparam Input The type defining the system's input.
+///
+/// @param mode The mode.
+///
+/// @return The packed mode.
+template <typename System, typename Input>
+inline auto pack(const Mode<System, Input> &mode) -> PackedMode<System, Input>
+{
+    return PackedMode<System, Input>{
+        .id     = mode.id,
+        .system = mode.system,
+        .input  = mode.input,
+    };
+}
+
+/// @brief Unpacks a mode.
+///
+/// @tparam System The type defining the system's dynamics.
+/// @tparam Input The type defining the system's input.
+///
+/// @param packed The packed mode.
+///
+/// @return The mode.
+template <typename System, typename Input>
+inline auto unpack(const PackedMode<System, Input> &packed) -> Mode<System, Input>
+{
+    Mode<System, Input> mode;
+    mode.id     = packed.id;
+    mode.system = packed.system;
+    mode.input  = packed.input;
+    return mode;
+}
+
+/// @brief Packs a set of modes, e.g., to copy them into shared memory.
+///
+/// @tparam System The type defining the system's dynamics.
+/// @tparam Input The type defining the system's input.
+///
+/// @param modes The modes.
+///
+/// @return The packed modes, in the same order.
+template <typename System, typename Input>
+inline auto pack_modes(const std::vector<Mode<System, Input>> &modes) -> std::vector<PackedMode<System, Input>>
+{
+    std::vector<PackedMode<System, Input>> packed;
+    packed.reserve(modes.size());
+    for (const auto &mode : modes) {
+        packed.emplace_back(flexman::core::pack(mode));
+    }
+    return packed;
+}
+
+/// @brief Checks if the sequence of a solution fits a packed solution.
+///
+/// @tparam Capacity The maximum number of mode executions.
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+///
+/// @param solution The solution.
+///
+/// @return True if the solution can be packed, false otherwise.
+template <std::size_t Capacity, typename State, typename Resources>
+inline auto fits(const Solution<State, Resources> &solution) noexcept -> bool
+{
+    return solution.sequence.size() <= Capacity;
+}
+
+/// @brief Packs a solution.
+///
+/// @tparam Capacity The maximum number of mode executions.
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+///
+/// @param solution The solution, whose sequence must fit the capacity.
+///
+/// @return The packed solution.
+template <std::size_t Capacity, typename State, typename Resources>
+inline auto pack(const Solution<State, Resources> &solution) -> PackedSolution<State, Resources, Capacity>
+{
+    if (!flexman::core::fits<Capacity>(solution)) {
+        throw std::invalid_argument("the sequence exceeds the capacity of the packed solution");
+    }
+    PackedSolution<State, Resources, Capacity> packed{
+        .state     = solution.state,
+        .resources = solution.resources,
+        .distance  = solution.distance,
+        .sequence  = {},
+    };
+    packed.sequence.length = solution.sequence.size();
+    for (std::size_t i = 0; i < packed.sequence.length; ++i) {
+        packed.sequence.executions[i] = solution.sequence[i];
+    }
+    return packed;
+}
+
+/// @brief Unpacks a solution.
+///
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+/// @tparam Capacity The maximum number of mode executions.
+///
+/// @param packed The packed solution.
+///
+/// @return The solution.
+template <typename State, typename Resources, std::size_t Capacity>
+inline auto unpack(const PackedSolution<State, Resources, Capacity> &packed) -> Solution<State, Resources>
+{
+    return Solution<State, Resources>{
+        .sequence  = std::vector<ModeExecution>(packed.sequence.begin(), packed.sequence.end()),
+        .state     = packed.state,
+        .resources = packed.resources,
+        .distance  = packed.distance,
+    };
+}
+
+/// @brief Packs a set of solutions.
+///
+/// @tparam Capacity The maximum number of mode executions.
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+///
+/// @param solutions The solutions, whose sequences must fit the capacity.
+///
+/// @return The packed solutions, in the same order.
+template <std::size_t Capacity, typename State, typename Resources>
+inline auto pack_solutions(const std::vector<Solution<State, Resources>> &solutions)
+    -> std::vector<PackedSolution<State, Resources, Capacity>>
+{
+    std::vector<PackedSolution<State, Resources, Capacity>> packed;
+    packed.reserve(solutions.size());
+    for (const auto &solution : solutions) {
+        packed.emplace_back(flexman::core::pack<Capacity>(solution));
+    }
+    return packed;
+}
+
+/// @brief Unpacks a set of solutions.
+///
+/// @tparam State The type representing the current state.
+/// @tparam Resources The type representing the resources used.
+/// @tparam Capacity The maximum number of mode executions.
+///
+/// @param packed The packed solutions.
+///
+/// @return The solutions, in the same order.
+template <typename State, typename Resources, std::size_t Capacity>
+inline auto unpack_solutions(const std::vector<PackedSolution<State, Resources, Capacity>> &packed)
+    -> std::vector<Solution<State, Resources>>
+{
+    std::vector<Solution<State, Resources>> solutions;
+    solutions.reserve(packed.size());
+    for (const auto &solution : packed) {
+        solutions.emplace_back(flexman::core::unpack(solution));
+    }
+    return solutions;
+}
+
+static_assert(std::is_trivially_copyable_v<ModeExecution>, "mode executions must be trivially copyable");
+static_assert(is_packable_v<PackedSequence<1>>, "packed sequences must be trivially copyable");
+
+} // namespace core
+} // namespace flexman
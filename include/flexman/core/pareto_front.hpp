@@ -12,6 +12,7 @@
 /// - The number of steps per iteration.
 /// - The current iteration number.
 /// - The total runtime of the optimization.
+/// - The hypervolume of the front, used to track convergence across strides.
 ///
 /// Additionally, the file provides:
 /// - A function to convert a `ParetoFront` instance into a string format.
@@ -54,6 +55,9 @@ struct ParetoFront {
     unsigned iteration;
     /// @brief The total runtime.
     double runtime;
+    /// @brief The hypervolume of the front, with respect to the reference
+    /// point of the search that produced it, zero if not computed.
+    double hypervolume = 0.0;
 
     /// @brief Converts a ParetoFront object to a string representation.
     ///
@@ -67,6 +71,7 @@ struct ParetoFront {
         ss << "        steps_per_iteration : " << steps_per_iteration << "\n";
         ss << "        iteration           : " << iteration << "\n";
         ss << "        runtime             : " << runtime << "\n";
+        ss << "        hypervolume         : " << hypervolume << "\n";
         ss << "        solutions           : \n";
         for (auto &solution : solutions) {
             ss << "            " << solution << "\n";
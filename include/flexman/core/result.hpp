@@ -8,6 +8,7 @@
 /// This file introduces the `Result` template structure, which aggregates
 /// a collection of `ParetoFront` instances, representing sets of non-dominated
 /// solutions in a multi-objective optimization problem. It provides:
+/// - The `StopReason` enumeration, describing why the search stopped.
 /// - A method to compute the total runtime across all Pareto fronts.
 /// - A function to convert a `Result` instance into a string format.
 /// - Overloaded stream output operators for easy logging and debugging.
@@ -32,6 +33,16 @@ namespace flexman
 namespace core
 {
 
+/// @brief Describes why a search stopped.
+enum class StopReason : unsigned char {
+    Completed, ///< All the strides were searched.
+    Timeout,   ///< The search went into timeout.
+    Converged, ///< The fronts stopped improving between strides.
+    UserStop,  ///< The user stopped the search.
+    Cancelled, ///< A checkpoint stopped the search, e.g., at its deadline.
+    Incomplete ///< Part of the search failed, e.g., a worker of a sharded search.
+};
+
 /// @brief Represents a simulation result, containing a set of Pareto fronts.
 ///
 /// @tparam State The type representing the system's state.
@@ -39,6 +50,7 @@ namespace core
 template <typename State, typename Resources>
 struct Result {
     std::vector<ParetoFront<State, Resources>> pareto_fronts; ///< The set of Pareto fronts.
+    StopReason stop_reason = StopReason::Completed;           ///< Why the search stopped.
 
     /// @brief Calculates the total runtime across all Pareto fronts.
     ///
@@ -62,6 +74,7 @@ struct Result {
         std::stringstream ss;
         ss << "Result{\n";
         ss << "    runtime : " << this->get_total_runtime() << "\n";
+        ss << "    stop_reason : " << static_cast<unsigned>(stop_reason) << "\n";
         ss << "    pareto_fronts : \n";
         for (auto &pareto_front : pareto_fronts) {
             ss << pareto_front;
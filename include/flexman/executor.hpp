@@ -0,0 +1,147 @@
+/// @file executor.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines a thread pool running independent tasks of the library.
+///
+/// @details
+/// This file provides the `Executor` class, a fixed-size pool of worker threads
+/// consuming a shared queue of tasks. Each submitted task returns a future,
+/// hence, the caller can wait for its result, and the exceptions it throws are
+/// rethrown by the future. The destructor waits for the tasks already queued.
+///
+/// The executor runs tasks of the same process, which share the address space
+/// and the managers; the managers must therefore be safe to use concurrently,
+/// which holds for the const interface of the managers of the library.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flexman
+{
+
+/// @brief Contains the facilities to run the library in parallel.
+namespace parallel
+{
+
+/// @brief A fixed-size pool of worker threads.
+class Executor
+{
+public:
+    /// @brief Starts the worker threads.
+    ///
+    /// @param workers The number of worker threads, zero uses one per hardware thread.
+    explicit Executor(std::size_t workers = 0)
+    {
+        if (workers == 0) {
+            workers = std::max(1U, std::thread::hardware_concurrency());
+        }
+        threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            threads.emplace_back([this]() { this->run(); });
+        }
+    }
+
+    /// @brief Copy constructor (deleted, the executor owns its threads).
+    Executor(const Executor &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, the executor owns its threads).
+    auto operator=(const Executor &other) -> Executor & = delete;
+
+    /// @brief Move constructor (deleted, the workers refer to the executor by address).
+    Executor(Executor &&other) = delete;
+
+    /// @brief Move assignment operator (deleted, the workers refer to the executor by address).
+    auto operator=(Executor &&other) -> Executor & = delete;
+
+    /// @brief Destructor, waits for the queued tasks and stops the workers.
+    ~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    /// @brief Queues a task.
+    ///
+    /// @param function The task, a callable without arguments.
+    ///
+    /// @return The future holding the result of the task.
+    template <typename Function>
+    auto submit(Function &&function) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+    {
+        using result_t = std::invoke_result_t<std::decay_t<Function>>;
+        // The queue holds copyable functions, hence, the task is shared.
+        auto task   = std::make_shared<std::packaged_task<result_t()>>(std::forward<Function>(function));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                throw std::runtime_error("cannot submit a task to a stopping executor");
+            }
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        available.notify_one();
+        return future;
+    }
+
+    /// @brief Returns the number of worker threads.
+    ///
+    /// @return The number of worker threads.
+    auto size() const noexcept -> std::size_t { return threads.size(); }
+
+private:
+    /// @brief The loop of a worker thread.
+    void run()
+    {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    /// @brief Protects the queue.
+    std::mutex mutex;
+    /// @brief Signals the workers that a task is queued, or that they must stop.
+    std::condition_variable available;
+    /// @brief The queued tasks.
+    std::deque<std::function<void()>> tasks;
+    /// @brief Whether the executor is stopping.
+    bool stopping = false;
+    /// @brief The worker threads.
+    std::vector<std::thread> threads;
+};
+
+} // namespace parallel
+} // namespace flexman
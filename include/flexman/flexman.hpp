@@ -7,6 +7,7 @@
 /// This file serves as the primary entry point for the Flexman library,
 /// providing access to its core components, including:
 /// - Data structures for managing modes, solutions, Pareto fronts, and results.
+/// - A ready-made manager for discrete-time linear systems.
 /// - Particle Swarm Optimization (PSO) utilities for optimizing mode execution sequences.
 /// - Search algorithms for systematically exploring and refining solutions.
 /// - Simulation functions for evaluating state evolution and mode transitions.
@@ -38,18 +39,47 @@ enum : unsigned char {
 };
 } // namespace flexman
 
+#include "flexman/async_logging.hpp"
+#include "flexman/executor.hpp"
+#include "flexman/scheduler.hpp"
+
+#include "flexman/core/fingerprint.hpp"
 #include "flexman/core/manager.hpp"
 #include "flexman/core/mode.hpp"
 #include "flexman/core/mode_execution.hpp"
+#include "flexman/core/packed.hpp"
 #include "flexman/core/pareto_front.hpp"
 #include "flexman/core/result.hpp"
 #include "flexman/core/solution.hpp"
 
+#include "flexman/integration/adaptive.hpp"
+#include "flexman/integration/block.hpp"
+#include "flexman/integration/rk4.hpp"
+#include "flexman/integration/rosenbrock.hpp"
+
+#include "flexman/linear/bidirectional.hpp"
+#include "flexman/linear/common.hpp"
+#include "flexman/linear/kernels.hpp"
+#include "flexman/linear/manager.hpp"
+#include "flexman/linear/precision.hpp"
+
 #include "flexman/pso/common.hpp"
 #include "flexman/pso/optimize.hpp"
 
 #include "flexman/search/common.hpp"
+#include "flexman/search/coordinator.hpp"
+#include "flexman/search/cost_model.hpp"
+#include "flexman/search/counters.hpp"
+#include "flexman/search/epsilon.hpp"
+#include "flexman/search/metrics.hpp"
+#include "flexman/search/partial_store.hpp"
+#include "flexman/search/policy.hpp"
+#include "flexman/search/rollout.hpp"
 #include "flexman/search/search.hpp"
+#include "flexman/search/seed.hpp"
+#include "flexman/search/sharded.hpp"
+#include "flexman/search/single_machine.hpp"
 
 #include "flexman/simulation/common.hpp"
+#include "flexman/simulation/parareal.hpp"
 #include "flexman/simulation/simulate.hpp"
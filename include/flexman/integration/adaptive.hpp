@@ -0,0 +1,218 @@
+/// @file adaptive.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements an adaptive Runge-Kutta integrator over blocks of states.
+///
+/// @details
+/// This file provides the `AdaptiveDopri5` class, the Dormand-Prince 5(4)
+/// method applied to all the states of a `StateBlock` at once. The lanes share
+/// the step size, which is controlled by the largest error estimate among the
+/// active lanes, so that every stage stays a single loop over the lanes. The
+/// last stage of an accepted step is the first one of the next step, hence,
+/// each step costs six evaluations of the derivative. The step size reached at
+/// the end of an integration is kept for the next one.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "flexman/integration/block.hpp"
+
+namespace flexman
+{
+namespace integration
+{
+
+/// @brief The Dormand-Prince 5(4) method with step size control, over blocks of states.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+template <typename Scalar, std::size_t N>
+class AdaptiveDopri5
+{
+public:
+    /// @brief Constructs the integrator.
+    ///
+    /// @param _absolute_tolerance The absolute tolerance on each component.
+    /// @param _relative_tolerance The relative tolerance on each component.
+    /// @param _initial_step The step size of the first attempt.
+    AdaptiveDopri5(Scalar _absolute_tolerance, Scalar _relative_tolerance, Scalar _initial_step)
+        : absolute_tolerance(_absolute_tolerance)
+        , relative_tolerance(_relative_tolerance)
+        , step(_initial_step)
+    {
+        if (!(absolute_tolerance > Scalar(0)) && !(relative_tolerance > Scalar(0))) {
+            throw std::invalid_argument("at least one tolerance must be greater than 0");
+        }
+        if (!(step > Scalar(0))) {
+            throw std::invalid_argument("initial_step must be greater than 0");
+        }
+    }
+
+    /// @brief Integrates all the active lanes of a block over an interval.
+    ///
+    /// @tparam Derivative The type of the derivative, called as
+    /// `derivative(time, x, dxdt)` on whole blocks.
+    /// @tparam Stop The type of the stop predicate, called as `stop(x, lane)`.
+    ///
+    /// @param derivative The derivative.
+    /// @param x The states, updated in place.
+    /// @param t0 The beginning of the interval.
+    /// @param t1 The end of the interval.
+    /// @param stop The stop predicate, checked after every accepted step.
+    ///
+    /// @return The work done.
+    template <typename Derivative, typename Stop = NeverStop>
+    auto integrate(const Derivative &derivative, StateBlock<Scalar, N> &x, Scalar t0, Scalar t1, const Stop &stop = {})
+        -> IntegrationStats
+    {
+        IntegrationStats stats;
+        if (!(t1 > t0) || (x.active_lanes() == 0)) {
+            return stats;
+        }
+        this->reserve(x.lanes());
+
+        // The Butcher tableau.
+        constexpr std::array<Scalar, 1> a2{Scalar(1) / Scalar(5)};
+        constexpr std::array<Scalar, 2> a3{Scalar(3) / Scalar(40), Scalar(9) / Scalar(40)};
+        constexpr std::array<Scalar, 3> a4{Scalar(44) / Scalar(45), Scalar(-56) / Scalar(15), Scalar(32) / Scalar(9)};
+        constexpr std::array<Scalar, 4> a5{
+            Scalar(19372) / Scalar(6561), Scalar(-25360) / Scalar(2187), Scalar(64448) / Scalar(6561),
+            Scalar(-212) / Scalar(729)};
+        constexpr std::array<Scalar, 5> a6{
+            Scalar(9017) / Scalar(3168), Scalar(-355) / Scalar(33), Scalar(46732) / Scalar(5247),
+            Scalar(49) / Scalar(176), Scalar(-5103) / Scalar(18656)};
+        constexpr std::array<Scalar, 5> b5{
+            Scalar(35) / Scalar(384), Scalar(500) / Scalar(1113), Scalar(125) / Scalar(192),
+            Scalar(-2187) / Scalar(6784), Scalar(11) / Scalar(84)};
+        constexpr std::array<Scalar, 6> b4{
+            Scalar(5179) / Scalar(57600), Scalar(7571) / Scalar(16695), Scalar(393) / Scalar(640),
+            Scalar(-92097) / Scalar(339200), Scalar(187) / Scalar(2100), Scalar(1) / Scalar(40)};
+
+        const Scalar span     = t1 - t0;
+        const Scalar smallest = std::numeric_limits<Scalar>::epsilon() * std::max(std::abs(t0), std::abs(t1));
+
+        Scalar t = t0;
+        Scalar h = std::min(step, span);
+        derivative(t, x, k1);
+        ++stats.evaluations;
+        while ((t1 - t) > smallest) {
+            const Scalar last = t1 - t;
+            h                 = std::min(h, last);
+            if (!(h > smallest)) {
+                throw std::runtime_error("step size underflow in the adaptive integrator");
+            }
+            // The stages, the solution of fifth order is the last one.
+            detail::combine(tmp, x, h, a2, {&k1});
+            derivative(t + (h / Scalar(5)), tmp, k2);
+            detail::combine(tmp, x, h, a3, {&k1, &k2});
+            derivative(t + (h * Scalar(3) / Scalar(10)), tmp, k3);
+            detail::combine(tmp, x, h, a4, {&k1, &k2, &k3});
+            derivative(t + (h * Scalar(4) / Scalar(5)), tmp, k4);
+            detail::combine(tmp, x, h, a5, {&k1, &k2, &k3, &k4});
+            derivative(t + (h * Scalar(8) / Scalar(9)), tmp, k5);
+            detail::combine(tmp, x, h, a6, {&k1, &k2, &k3, &k4, &k5});
+            derivative(t + h, tmp, k6);
+            detail::combine(candidate, x, h, b5, {&k1, &k3, &k4, &k5, &k6});
+            derivative(t + h, candidate, k7);
+            // The embedded solution of fourth order.
+            detail::combine(tmp, x, h, b4, {&k1, &k3, &k4, &k5, &k6, &k7});
+            stats.evaluations += 6;
+
+            const Scalar error = this->error_norm(x, candidate, tmp);
+            if (error <= Scalar(1)) {
+                // Accept the step, the last stage is the first of the next one.
+                t = (h < last) ? (t + h) : t1;
+                detail::blend(x, candidate);
+                std::swap(k1, k7);
+                ++stats.steps;
+                h *= this->step_factor(error, Scalar(5));
+                if (detail::apply_stop(x, stop) == 0) {
+                    break;
+                }
+            } else {
+                ++stats.rejected;
+                h *= this->step_factor(error, Scalar(1));
+            }
+        }
+        step = h;
+        return stats;
+    }
+
+private:
+    /// @brief Sizes the stages for the given number of lanes.
+    ///
+    /// @param lanes The number of lanes.
+    void reserve(std::size_t lanes)
+    {
+        if (tmp.lanes() != lanes) {
+            for (auto *block : {&k1, &k2, &k3, &k4, &k5, &k6, &k7, &tmp, &candidate}) {
+                block->resize(lanes);
+            }
+        }
+    }
+
+    /// @brief Computes the largest scaled error among the active lanes.
+    ///
+    /// @param x The states at the beginning of the step.
+    /// @param high The solution of fifth order.
+    /// @param low The solution of fourth order.
+    ///
+    /// @return The error, the step is accepted when it is not greater than one.
+    auto error_norm(const StateBlock<Scalar, N> &x, const StateBlock<Scalar, N> &high, const StateBlock<Scalar, N> &low)
+        const -> Scalar
+    {
+        const std::size_t lanes = x.lanes();
+        const Scalar *mask      = x.active_mask();
+        Scalar error            = Scalar(0);
+        for (std::size_t i = 0; i < N; ++i) {
+            const Scalar *x0 = x.component(i);
+            const Scalar *x5 = high.component(i);
+            const Scalar *x4 = low.component(i);
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const Scalar scale = absolute_tolerance +
+                                     (relative_tolerance * std::max(std::abs(x0[lane]), std::abs(x5[lane])));
+                error = std::max(error, mask[lane] * std::abs(x5[lane] - x4[lane]) / scale);
+            }
+        }
+        return error;
+    }
+
+    /// @brief Computes the factor of the next step size.
+    ///
+    /// @param error The error of the last step.
+    /// @param largest The largest factor allowed.
+    ///
+    /// @return The factor.
+    static auto step_factor(Scalar error, Scalar largest) -> Scalar
+    {
+        if (!(error > std::numeric_limits<Scalar>::min())) {
+            return largest;
+        }
+        const Scalar factor = Scalar(0.9) * std::pow(error, Scalar(-0.2));
+        return std::clamp(factor, Scalar(0.2), largest);
+    }
+
+    /// @brief The absolute tolerance on each component.
+    Scalar absolute_tolerance;
+    /// @brief The relative tolerance on each component.
+    Scalar relative_tolerance;
+    /// @brief The step size of the next attempt.
+    Scalar step;
+    /// @brief The stages, reused across integrations.
+    StateBlock<Scalar, N> k1, k2, k3, k4, k5, k6, k7, tmp, candidate;
+};
+
+} // namespace integration
+} // namespace flexman
@@ -0,0 +1,441 @@
+/// @file block.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines a block of states integrated together.
+///
+/// @details
+/// The partial solutions extended with the same mode integrate the same
+/// differential equation from different initial states. Storing those states
+/// as a structure of arrays, i.e., each component of all the states
+/// contiguously, lets the integrators apply every operation to all the states
+/// in a single loop, which the compiler vectorizes. This file provides:
+/// - The `StateBlock` class, a structure of arrays of states, with a mask of
+///   the lanes that are still integrated.
+/// - The `LinearDerivative` functor, the derivative of a linear system with a
+///   constant input, evaluated over a whole block.
+/// - The `IntegrationStats` structure, which counts the work of an integrator.
+/// - The `NeverStop` predicate, for integrations without a stop condition.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace flexman
+{
+
+/// @brief Contains the integrators advancing blocks of states together.
+namespace integration
+{
+
+/// @brief A block of states, stored as a structure of arrays.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+template <typename Scalar, std::size_t N>
+class StateBlock
+{
+public:
+    /// @brief Constructs a block.
+    ///
+    /// @param lanes The number of states in the block.
+    explicit StateBlock(std::size_t lanes = 0) { this->resize(lanes); }
+
+    /// @brief Resizes the block, zeroing the states and activating all the lanes.
+    ///
+    /// @param lanes The number of states in the block.
+    void resize(std::size_t lanes)
+    {
+        lane_count = lanes;
+        values.assign(N * lanes, Scalar(0));
+        mask.assign(lanes, Scalar(1));
+    }
+
+    /// @brief Returns the number of states in the block.
+    ///
+    /// @return The number of states in the block.
+    auto lanes() const noexcept -> std::size_t { return lane_count; }
+
+    /// @brief Returns a component of all the states.
+    ///
+    /// @param index The index of the component.
+    ///
+    /// @return A pointer to the component of the first state, the others follow.
+    auto component(std::size_t index) noexcept -> Scalar * { return values.data() + (index * lane_count); }
+
+    /// @brief Returns a component of all the states.
+    ///
+    /// @param index The index of the component.
+    ///
+    /// @return A pointer to the component of the first state, the others follow.
+    auto component(std::size_t index) const noexcept -> const Scalar *
+    {
+        return values.data() + (index * lane_count);
+    }
+
+    /// @brief Accesses a component of a state.
+    ///
+    /// @param index The index of the component.
+    /// @param lane The index of the state.
+    ///
+    /// @return A reference to the component.
+    auto operator()(std::size_t index, std::size_t lane) noexcept -> Scalar &
+    {
+        return values[(index * lane_count) + lane];
+    }
+
+    /// @brief Accesses a component of a state.
+    ///
+    /// @param index The index of the component.
+    /// @param lane The index of the state.
+    ///
+    /// @return The component.
+    auto operator()(std::size_t index, std::size_t lane) const noexcept -> Scalar
+    {
+        return values[(index * lane_count) + lane];
+    }
+
+    /// @brief Copies a state into a lane.
+    ///
+    /// @tparam State The type of the state, which must be indexable.
+    ///
+    /// @param lane The index of the lane.
+    /// @param state The state.
+    template <typename State>
+    void load(std::size_t lane, const State &state)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            (*this)(i, lane) = static_cast<Scalar>(state[i]);
+        }
+    }
+
+    /// @brief Copies a lane into a state.
+    ///
+    /// @tparam State The type of the state, which must be indexable.
+    ///
+    /// @param lane The index of the lane.
+    /// @param state The state.
+    template <typename State>
+    void store(std::size_t lane, State &state) const
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            state[i] = (*this)(i, lane);
+        }
+    }
+
+    /// @brief Checks if a lane is still integrated.
+    ///
+    /// @param lane The index of the lane.
+    ///
+    /// @return True if the lane is active, false if it stopped.
+    auto is_active(std::size_t lane) const noexcept -> bool { return mask[lane] > Scalar(0); }
+
+    /// @brief Stops integrating a lane, its state is frozen from now on.
+    ///
+    /// @param lane The index of the lane.
+    void deactivate(std::size_t lane) noexcept { mask[lane] = Scalar(0); }
+
+    /// @brief Returns the number of lanes still integrated.
+    ///
+    /// @return The number of active lanes.
+    auto active_lanes() const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(
+            std::count_if(mask.begin(), mask.end(), [](Scalar active) { return active > Scalar(0); }));
+    }
+
+    /// @brief Returns the mask of the lanes, one for the active lanes and zero
+    /// for the stopped ones, so that updates can be blended without branches.
+    ///
+    /// @return A pointer to the mask of the first lane, the others follow.
+    auto active_mask() const noexcept -> const Scalar * { return mask.data(); }
+
+private:
+    /// @brief The number of states.
+    std::size_t lane_count = 0;
+    /// @brief The components, each one contiguous for all the states.
+    std::vector<Scalar> values;
+    /// @brief One for the active lanes, zero for the stopped ones.
+    std::vector<Scalar> mask;
+};
+
+/// @brief The derivative of a linear system with a constant input, i.e.,
+/// `dx/dt = A x + c`, where `c = B u`.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+template <typename Scalar, std::size_t N>
+struct LinearDerivative {
+    /// @brief The state matrix, row-major.
+    std::array<std::array<Scalar, N>, N> a;
+    /// @brief The constant term.
+    std::array<Scalar, N> c;
+
+    /// @brief Builds the derivative from any indexable matrix and vector.
+    ///
+    /// @tparam MatrixA The type of the state matrix.
+    /// @tparam VectorC The type of the constant term.
+    ///
+    /// @param matrix The state matrix.
+    /// @param constant The constant term.
+    ///
+    /// @return The derivative.
+    template <typename MatrixA, typename VectorC>
+    static auto from(const MatrixA &matrix, const VectorC &constant) -> LinearDerivative
+    {
+        LinearDerivative derivative{};
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                derivative.a[i][j] = static_cast<Scalar>(matrix[i][j]);
+            }
+            derivative.c[i] = static_cast<Scalar>(constant[i]);
+        }
+        return derivative;
+    }
+
+    /// @brief Evaluates the derivative of all the states of a block.
+    ///
+    /// @param time The time, unused since the system is time-invariant.
+    /// @param x The states.
+    /// @param dxdt Where the derivatives are written.
+    void operator()(Scalar time, const StateBlock<Scalar, N> &x, StateBlock<Scalar, N> &dxdt) const
+    {
+        (void)time;
+        const std::size_t lanes = x.lanes();
+        std::array<const Scalar *, N> in;
+        for (std::size_t j = 0; j < N; ++j) {
+            in[j] = x.component(j);
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            Scalar *out     = dxdt.component(i);
+            const auto &row = a[i];
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                Scalar sum = c[i];
+                for (std::size_t j = 0; j < N; ++j) {
+                    sum += row[j] * in[j][lane];
+                }
+                out[lane] = sum;
+            }
+        }
+    }
+};
+
+/// @brief Counts the work of an integrator.
+struct IntegrationStats {
+    /// @brief The number of accepted steps.
+    std::size_t steps       = 0;
+    /// @brief The number of rejected steps.
+    std::size_t rejected    = 0;
+    /// @brief The number of evaluations of the derivative, over the whole block.
+    std::size_t evaluations = 0;
+
+    /// @brief Accumulates the work of another integration.
+    ///
+    /// @param other The other counts.
+    ///
+    /// @return A reference to these counts.
+    auto operator+=(const IntegrationStats &other) noexcept -> IntegrationStats &
+    {
+        steps += other.steps;
+        rejected += other.rejected;
+        evaluations += other.evaluations;
+        return *this;
+    }
+};
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Computes a stage of an integrator over a whole block, i.e.,
+/// `out = x + h * sum(weights[s] * stages[s])`.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+/// @tparam S The number of stages.
+///
+/// @param out Where the result is written.
+/// @param x The states.
+/// @param h The step size.
+/// @param weights The weights of the stages.
+/// @param stages The stages.
+template <typename Scalar, std::size_t N, std::size_t S>
+void combine(
+    StateBlock<Scalar, N> &out,
+    const StateBlock<Scalar, N> &x,
+    Scalar h,
+    const std::array<Scalar, S> &weights,
+    const std::array<const StateBlock<Scalar, N> *, S> &stages)
+{
+    const std::size_t lanes = x.lanes();
+    std::array<Scalar, S> scaled;
+    for (std::size_t s = 0; s < S; ++s) {
+        scaled[s] = h * weights[s];
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar *destination  = out.component(i);
+        const Scalar *origin = x.component(i);
+        std::array<const Scalar *, S> inputs;
+        for (std::size_t s = 0; s < S; ++s) {
+            inputs[s] = stages[s]->component(i);
+        }
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            Scalar sum = origin[lane];
+            for (std::size_t s = 0; s < S; ++s) {
+                sum += scaled[s] * inputs[s][lane];
+            }
+            destination[lane] = sum;
+        }
+    }
+}
+
+/// @brief Advances the active lanes of a block by a combination of stages,
+/// i.e., `x += mask * h * sum(weights[s] * stages[s])`, leaving the stopped
+/// lanes untouched, without branching on the mask.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+/// @tparam S The number of stages.
+///
+/// @param x The states, updated in place.
+/// @param h The step size.
+/// @param weights The weights of the stages.
+/// @param stages The stages.
+template <typename Scalar, std::size_t N, std::size_t S>
+void increment(
+    StateBlock<Scalar, N> &x,
+    Scalar h,
+    const std::array<Scalar, S> &weights,
+    const std::array<const StateBlock<Scalar, N> *, S> &stages)
+{
+    const std::size_t lanes = x.lanes();
+    const Scalar *mask      = x.active_mask();
+    std::array<Scalar, S> scaled;
+    for (std::size_t s = 0; s < S; ++s) {
+        scaled[s] = h * weights[s];
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar *destination = x.component(i);
+        std::array<const Scalar *, S> inputs;
+        for (std::size_t s = 0; s < S; ++s) {
+            inputs[s] = stages[s]->component(i);
+        }
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            Scalar sum = Scalar(0);
+            for (std::size_t s = 0; s < S; ++s) {
+                sum += scaled[s] * inputs[s][lane];
+            }
+            destination[lane] += mask[lane] * sum;
+        }
+    }
+}
+
+/// @brief Moves the active lanes of a block to their candidate states, leaving
+/// the stopped lanes untouched.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+///
+/// @param x The states, updated in place.
+/// @param candidate The candidate states.
+template <typename Scalar, std::size_t N>
+void blend(StateBlock<Scalar, N> &x, const StateBlock<Scalar, N> &candidate)
+{
+    const std::size_t lanes = x.lanes();
+    const Scalar *mask      = x.active_mask();
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar *destination  = x.component(i);
+        const Scalar *source = candidate.component(i);
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            destination[lane] = (mask[lane] > Scalar(0)) ? source[lane] : destination[lane];
+        }
+    }
+}
+
+/// @brief Applies an affine map to the active lanes of a block, i.e.,
+/// `x = P x + q`, leaving the stopped lanes untouched.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+///
+/// @param x The states, updated in place.
+/// @param out A block of the same size, used as scratch.
+/// @param p The matrix of the map, row-major.
+/// @param q The constant term of the map.
+template <typename Scalar, std::size_t N>
+void affine(
+    StateBlock<Scalar, N> &x,
+    StateBlock<Scalar, N> &out,
+    const std::array<std::array<Scalar, N>, N> &p,
+    const std::array<Scalar, N> &q)
+{
+    const std::size_t lanes = x.lanes();
+    std::array<const Scalar *, N> in;
+    for (std::size_t j = 0; j < N; ++j) {
+        in[j] = x.component(j);
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar *destination = out.component(i);
+        const auto &row     = p[i];
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            Scalar sum = q[i];
+            for (std::size_t j = 0; j < N; ++j) {
+                sum += row[j] * in[j][lane];
+            }
+            destination[lane] = sum;
+        }
+    }
+    blend(x, out);
+}
+
+/// @brief Stops the active lanes that satisfy the stop predicate.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+/// @tparam Stop The type of the stop predicate.
+///
+/// @param x The states.
+/// @param stop The stop predicate.
+///
+/// @return The number of lanes still active.
+template <typename Scalar, std::size_t N, typename Stop>
+auto apply_stop(StateBlock<Scalar, N> &x, const Stop &stop) -> std::size_t
+{
+    std::size_t active = 0;
+    for (std::size_t lane = 0; lane < x.lanes(); ++lane) {
+        if (x.is_active(lane)) {
+            if (stop(x, lane)) {
+                x.deactivate(lane);
+            } else {
+                ++active;
+            }
+        }
+    }
+    return active;
+}
+
+} // namespace detail
+
+/// @brief A stop predicate that never stops a lane.
+struct NeverStop {
+    /// @brief Checks if a lane must stop.
+    ///
+    /// @tparam Block The type of the block.
+    ///
+    /// @return Always false.
+    template <typename Block>
+    auto operator()(const Block &, std::size_t) const noexcept -> bool
+    {
+        return false;
+    }
+};
+
+} // namespace integration
+} // namespace flexman
@@ -0,0 +1,208 @@
+/// @file rk4.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements a fixed-step Runge-Kutta integrator over blocks of states.
+///
+/// @details
+/// This file provides the `FixedStepRk4` class, the classic fourth-order
+/// Runge-Kutta method applied to all the states of a `StateBlock` at once.
+/// Each stage is a single loop over the lanes of the block, and the lanes that
+/// meet the stop condition are frozen through the mask of the block. On a
+/// linear system, the four stages of a step collapse into a single affine map
+/// of the state, computed once per integration, hence, a step costs a single
+/// matrix-vector product per lane. The stop condition is checked after every
+/// step, hence, a stopped lane holds the first state that satisfies it.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flexman/integration/block.hpp"
+
+namespace flexman
+{
+namespace integration
+{
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Computes a term of Horner's scheme, `I + h A M`.
+///
+/// @tparam Scalar The type of the components.
+/// @tparam N The size of the matrices.
+///
+/// @param a The matrix A.
+/// @param m The matrix M.
+/// @param h The factor.
+///
+/// @return The term.
+template <typename Scalar, std::size_t N>
+auto series_term(
+    const std::array<std::array<Scalar, N>, N> &a,
+    const std::array<std::array<Scalar, N>, N> &m,
+    Scalar h) -> std::array<std::array<Scalar, N>, N>
+{
+    std::array<std::array<Scalar, N>, N> term{};
+    for (std::size_t i = 0; i < N; ++i) {
+        term[i][i] = Scalar(1);
+        for (std::size_t j = 0; j < N; ++j) {
+            for (std::size_t k = 0; k < N; ++k) {
+                term[i][j] += h * a[i][k] * m[k][j];
+            }
+        }
+    }
+    return term;
+}
+
+} // namespace detail
+
+/// @brief The classic fourth-order Runge-Kutta method, over blocks of states.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+template <typename Scalar, std::size_t N>
+class FixedStepRk4
+{
+public:
+    /// @brief Constructs the integrator.
+    ///
+    /// @param _step The largest step size, the interval is split in equal steps no larger than it.
+    explicit FixedStepRk4(Scalar _step)
+        : step(_step)
+    {
+        if (!(step > Scalar(0))) {
+            throw std::invalid_argument("step must be greater than 0");
+        }
+    }
+
+    /// @brief Integrates all the active lanes of a block over an interval.
+    ///
+    /// @tparam Derivative The type of the derivative, called as
+    /// `derivative(time, x, dxdt)` on whole blocks.
+    /// @tparam Stop The type of the stop predicate, called as `stop(x, lane)`.
+    ///
+    /// @param derivative The derivative.
+    /// @param x The states, updated in place.
+    /// @param t0 The beginning of the interval.
+    /// @param t1 The end of the interval.
+    /// @param stop The stop predicate.
+    ///
+    /// @return The work done.
+    template <typename Derivative, typename Stop = NeverStop>
+    auto integrate(const Derivative &derivative, StateBlock<Scalar, N> &x, Scalar t0, Scalar t1, const Stop &stop = {})
+        -> IntegrationStats
+    {
+        IntegrationStats stats;
+        if (!(t1 > t0) || (x.active_lanes() == 0)) {
+            return stats;
+        }
+        this->reserve(x.lanes());
+
+        // Split the interval in equal steps, tolerating the rounding of t1 - t0.
+        const auto count = std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(((t1 - t0) / step) - static_cast<Scalar>(1e-6))));
+        const Scalar h    = (t1 - t0) / static_cast<Scalar>(count);
+        const Scalar half = h / Scalar(2);
+
+        // On a linear system, a step is an affine map of the state.
+        if constexpr (std::is_same_v<Derivative, LinearDerivative<Scalar, N>>) {
+            const auto [p, q] = this->linear_step(derivative, h);
+            for (std::size_t i = 0; i < count; ++i) {
+                detail::affine(x, tmp, p, q);
+                stats.evaluations += 4;
+                ++stats.steps;
+                if (detail::apply_stop(x, stop) == 0) {
+                    break;
+                }
+            }
+            return stats;
+        }
+
+        constexpr std::array<Scalar, 1> single{Scalar(1)};
+        const std::array<Scalar, 4> weights{
+            Scalar(1) / Scalar(6), Scalar(1) / Scalar(3), Scalar(1) / Scalar(3), Scalar(1) / Scalar(6)};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const Scalar t = t0 + (static_cast<Scalar>(i) * h);
+            derivative(t, x, k1);
+            detail::combine(tmp, x, half, single, {&k1});
+            derivative(t + half, tmp, k2);
+            detail::combine(tmp, x, half, single, {&k2});
+            derivative(t + half, tmp, k3);
+            detail::combine(tmp, x, h, single, {&k3});
+            derivative(t + h, tmp, k4);
+            detail::increment(x, h, weights, {&k1, &k2, &k3, &k4});
+            stats.evaluations += 4;
+            ++stats.steps;
+            if (detail::apply_stop(x, stop) == 0) {
+                break;
+            }
+        }
+        return stats;
+    }
+
+private:
+    /// @brief Computes the affine map applied by a step on a linear system,
+    /// `x' = P x + q`, where `P = I + hA + (hA)^2/2 + (hA)^3/6 + (hA)^4/24` and
+    /// `q = h (I + hA/2 + (hA)^2/6 + (hA)^3/24) c`.
+    ///
+    /// @param derivative The derivative of the linear system.
+    /// @param h The step size.
+    ///
+    /// @return The matrix and the constant term of the map.
+    static auto linear_step(const LinearDerivative<Scalar, N> &derivative, Scalar h)
+        -> std::pair<std::array<std::array<Scalar, N>, N>, std::array<Scalar, N>>
+    {
+        using matrix_t = std::array<std::array<Scalar, N>, N>;
+        // Horner's scheme, the series of q is the one of P before its last term.
+        matrix_t p{};
+        for (std::size_t i = 0; i < N; ++i) {
+            p[i][i] = Scalar(1);
+        }
+        for (const Scalar factor : {Scalar(4), Scalar(3), Scalar(2)}) {
+            p = detail::series_term(derivative.a, p, h / factor);
+        }
+        const matrix_t r = p;
+        p                = detail::series_term(derivative.a, p, h);
+        std::array<Scalar, N> q{};
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                q[i] += h * r[i][j] * derivative.c[j];
+            }
+        }
+        return {p, q};
+    }
+
+    /// @brief Sizes the stages for the given number of lanes.
+    ///
+    /// @param lanes The number of lanes.
+    void reserve(std::size_t lanes)
+    {
+        if (tmp.lanes() != lanes) {
+            for (auto *block : {&k1, &k2, &k3, &k4, &tmp}) {
+                block->resize(lanes);
+            }
+        }
+    }
+
+    /// @brief The largest step size.
+    Scalar step;
+    /// @brief The stages, reused across integrations.
+    StateBlock<Scalar, N> k1, k2, k3, k4, tmp;
+};
+
+} // namespace integration
+} // namespace flexman
@@ -0,0 +1,322 @@
+/// @file rosenbrock.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements a linearly implicit integrator for stiff systems, over
+/// blocks of states.
+///
+/// @details
+/// Explicit methods are only stable for steps shorter than the fastest time
+/// constant of the system, hence, a stiff system, e.g., with a fast electrical
+/// pole and slow mechanics, forces many more steps than its accuracy needs.
+/// This file provides the `Rosenbrock2` class, the two-stage Rosenbrock-W
+/// method ROS2, which is L-stable, and whose step size is therefore chosen by
+/// accuracy alone. Each stage solves a linear system with the matrix
+/// `W = I - gamma h J`, where `J` approximates the Jacobian of the derivative:
+/// - On a `LinearDerivative`, `J` is exact and shared by all the lanes, and a
+///   step collapses into a single affine map of the state, computed once per
+///   integration.
+/// - On any other derivative, `J` is estimated per lane by finite differences
+///   at the beginning of the integration, and then frozen over the interval;
+///   ROS2 keeps its second order for any `J`, which is what makes it a W-method.
+///
+/// The derivative is assumed not to depend explicitly on time.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flexman/integration/block.hpp"
+#include "flexman/linear/kernels.hpp"
+
+namespace flexman
+{
+namespace integration
+{
+
+/// @brief The two-stage Rosenbrock-W method ROS2, over blocks of states.
+///
+/// @tparam Scalar The type of the state components.
+/// @tparam N The number of components of each state.
+template <typename Scalar, std::size_t N>
+class Rosenbrock2
+{
+public:
+    /// @brief Constructs the integrator.
+    ///
+    /// @param _step The largest step size, the interval is split in equal steps no larger than it.
+    explicit Rosenbrock2(Scalar _step)
+        : step(_step)
+    {
+        if (!(step > Scalar(0))) {
+            throw std::invalid_argument("step must be greater than 0");
+        }
+    }
+
+    /// @brief Integrates all the active lanes of a block over an interval.
+    ///
+    /// @tparam Derivative The type of the derivative, called as
+    /// `derivative(time, x, dxdt)` on whole blocks.
+    /// @tparam Stop The type of the stop predicate, called as `stop(x, lane)`.
+    ///
+    /// @param derivative The derivative.
+    /// @param x The states, updated in place.
+    /// @param t0 The beginning of the interval.
+    /// @param t1 The end of the interval.
+    /// @param stop The stop predicate, checked after every step.
+    ///
+    /// @return The work done.
+    template <typename Derivative, typename Stop = NeverStop>
+    auto integrate(const Derivative &derivative, StateBlock<Scalar, N> &x, Scalar t0, Scalar t1, const Stop &stop = {})
+        -> IntegrationStats
+    {
+        IntegrationStats stats;
+        if (!(t1 > t0) || (x.active_lanes() == 0)) {
+            return stats;
+        }
+        this->reserve(x.lanes());
+
+        // Split the interval in equal steps, tolerating the rounding of t1 - t0.
+        const auto count = std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(((t1 - t0) / step) - static_cast<Scalar>(1e-6))));
+        const Scalar h = (t1 - t0) / static_cast<Scalar>(count);
+
+        // On a linear system, a step is an affine map of the state.
+        if constexpr (std::is_same_v<Derivative, LinearDerivative<Scalar, N>>) {
+            const auto map = this->linear_step(derivative, h);
+            for (std::size_t i = 0; i < count; ++i) {
+                detail::affine(x, f0, map.first, map.second);
+                stats.evaluations += 2;
+                ++stats.steps;
+                if (detail::apply_stop(x, stop) == 0) {
+                    break;
+                }
+            }
+            return stats;
+        }
+
+        constexpr std::array<Scalar, 1> single{Scalar(1)};
+        constexpr std::array<Scalar, 2> weights{Scalar(3) / Scalar(2), Scalar(1) / Scalar(2)};
+
+        // Estimate the Jacobian, and invert W, once for the whole interval.
+        this->invert_w(derivative, x, t0, h);
+        stats.evaluations += N + 1;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const Scalar t = t0 + (static_cast<Scalar>(i) * h);
+            // W k1 = f(x).
+            derivative(t, x, f0);
+            this->solve(k1, f0);
+            // W k2 = f(x + h k1) - 2 k1.
+            detail::combine(tmp, x, h, single, {&k1});
+            derivative(t + h, tmp, f1);
+            detail::combine(tmp, f1, Scalar(-2), single, {&k1});
+            this->solve(k2, tmp);
+            // x += 3/2 h k1 + 1/2 h k2.
+            detail::increment(x, h, weights, {&k1, &k2});
+            stats.evaluations += 2;
+            ++stats.steps;
+            if (detail::apply_stop(x, stop) == 0) {
+                break;
+            }
+        }
+        return stats;
+    }
+
+private:
+    /// @brief The matrix type.
+    using matrix_t = std::array<std::array<Scalar, N>, N>;
+    /// @brief The vector type.
+    using vector_t = std::array<Scalar, N>;
+
+    /// @brief The parameter of the method, `1 + 1/sqrt(2)`.
+    static constexpr Scalar gamma = Scalar(1.7071067811865475244);
+
+    /// @brief Inverts the matrix `I - gamma h J`.
+    ///
+    /// @param jacobian The Jacobian.
+    /// @param h The step size.
+    ///
+    /// @return The inverse.
+    static auto inverse_of_w(const matrix_t &jacobian, Scalar h) -> matrix_t
+    {
+        matrix_t w{};
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                w[i][j] = ((i == j) ? Scalar(1) : Scalar(0)) - (gamma * h * jacobian[i][j]);
+            }
+        }
+        const auto inverse = flexman::linear::invert(w, std::numeric_limits<Scalar>::epsilon());
+        if (!inverse) {
+            throw std::runtime_error("singular matrix in the Rosenbrock integrator");
+        }
+        return *inverse;
+    }
+
+    /// @brief Computes the affine map applied by a step on a linear system,
+    /// `x' = P x + q`, by applying the step to the origin and to the basis.
+    ///
+    /// @param derivative The derivative of the linear system.
+    /// @param h The step size.
+    ///
+    /// @return The matrix and the constant term of the map.
+    static auto linear_step(const LinearDerivative<Scalar, N> &derivative, Scalar h) -> std::pair<matrix_t, vector_t>
+    {
+        const matrix_t inverse = inverse_of_w(derivative.a, h);
+        // One step from the given state, with or without the constant term.
+        auto apply = [&](const vector_t &state, bool affine) {
+            auto evaluate = [&](const vector_t &y) {
+                vector_t dydt{};
+                for (std::size_t r = 0; r < N; ++r) {
+                    dydt[r] = affine ? derivative.c[r] : Scalar(0);
+                    for (std::size_t c = 0; c < N; ++c) {
+                        dydt[r] += derivative.a[r][c] * y[c];
+                    }
+                }
+                return dydt;
+            };
+            auto solve = [&](const vector_t &rhs) {
+                vector_t out{};
+                for (std::size_t r = 0; r < N; ++r) {
+                    for (std::size_t c = 0; c < N; ++c) {
+                        out[r] += inverse[r][c] * rhs[c];
+                    }
+                }
+                return out;
+            };
+            const vector_t k1 = solve(evaluate(state));
+            vector_t stage{};
+            for (std::size_t r = 0; r < N; ++r) {
+                stage[r] = state[r] + (h * k1[r]);
+            }
+            vector_t rhs = evaluate(stage);
+            for (std::size_t r = 0; r < N; ++r) {
+                rhs[r] -= Scalar(2) * k1[r];
+            }
+            const vector_t k2 = solve(rhs);
+            vector_t next{};
+            for (std::size_t r = 0; r < N; ++r) {
+                next[r] = state[r] + (h * ((Scalar(1.5) * k1[r]) + (Scalar(0.5) * k2[r])));
+            }
+            return next;
+        };
+        // The constant term is the step from the origin, and the columns of
+        // the matrix are the steps from the basis, without the constant term.
+        std::pair<matrix_t, vector_t> map{};
+        map.second = apply(vector_t{}, true);
+        for (std::size_t c = 0; c < N; ++c) {
+            vector_t basis{};
+            basis[c]           = Scalar(1);
+            const vector_t col = apply(basis, false);
+            for (std::size_t r = 0; r < N; ++r) {
+                map.first[r][c] = col[r];
+            }
+        }
+        return map;
+    }
+
+    /// @brief Estimates the Jacobian of each active lane by forward
+    /// differences, and stores the inverse of its matrix W.
+    ///
+    /// @tparam Derivative The type of the derivative.
+    ///
+    /// @param derivative The derivative.
+    /// @param x The states.
+    /// @param t The time of the estimate.
+    /// @param h The step size.
+    template <typename Derivative>
+    void invert_w(const Derivative &derivative, const StateBlock<Scalar, N> &x, Scalar t, Scalar h)
+    {
+        const std::size_t lanes = x.lanes();
+        const Scalar root       = std::sqrt(std::numeric_limits<Scalar>::epsilon());
+        derivative(t, x, f0);
+        // Perturb one component of all the lanes at a time.
+        for (std::size_t c = 0; c < N; ++c) {
+            tmp = x;
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                tmp(c, lane) += root * std::max(Scalar(1), std::abs(x(c, lane)));
+            }
+            derivative(t, tmp, columns[c]);
+            for (std::size_t r = 0; r < N; ++r) {
+                Scalar *column       = columns[c].component(r);
+                const Scalar *origin = f0.component(r);
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    column[lane] = (column[lane] - origin[lane]) / (tmp(c, lane) - x(c, lane));
+                }
+            }
+        }
+        // Invert the matrix of each lane.
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            matrix_t jacobian{};
+            if (x.is_active(lane)) {
+                for (std::size_t r = 0; r < N; ++r) {
+                    for (std::size_t c = 0; c < N; ++c) {
+                        jacobian[r][c] = columns[c](r, lane);
+                    }
+                }
+            }
+            const matrix_t inverse = inverse_of_w(jacobian, h);
+            for (std::size_t r = 0; r < N; ++r) {
+                for (std::size_t c = 0; c < N; ++c) {
+                    columns[c](r, lane) = inverse[r][c];
+                }
+            }
+        }
+    }
+
+    /// @brief Solves the linear system of each lane, with the stored inverses.
+    ///
+    /// @param out Where the solutions are written.
+    /// @param rhs The right-hand sides.
+    void solve(StateBlock<Scalar, N> &out, const StateBlock<Scalar, N> &rhs) const
+    {
+        const std::size_t lanes = rhs.lanes();
+        for (std::size_t r = 0; r < N; ++r) {
+            Scalar *destination = out.component(r);
+            std::fill(destination, destination + lanes, Scalar(0));
+            for (std::size_t c = 0; c < N; ++c) {
+                const Scalar *coefficient = columns[c].component(r);
+                const Scalar *source      = rhs.component(c);
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    destination[lane] += coefficient[lane] * source[lane];
+                }
+            }
+        }
+    }
+
+    /// @brief Sizes the stages for the given number of lanes.
+    ///
+    /// @param lanes The number of lanes.
+    void reserve(std::size_t lanes)
+    {
+        if (tmp.lanes() != lanes) {
+            for (auto *block : {&k1, &k2, &f0, &f1, &tmp}) {
+                block->resize(lanes);
+            }
+            for (auto &column : columns) {
+                column.resize(lanes);
+            }
+        }
+    }
+
+    /// @brief The largest step size.
+    Scalar step;
+    /// @brief The stages, reused across integrations.
+    StateBlock<Scalar, N> k1, k2, f0, f1, tmp;
+    /// @brief The columns of the Jacobian of each lane, then of the inverse of its W.
+    std::array<StateBlock<Scalar, N>, N> columns;
+};
+
+} // namespace integration
+} // namespace flexman
@@ -0,0 +1,660 @@
+/// @file bidirectional.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements a meet-in-the-middle search for the linear managers.
+///
+/// @details
+/// When the state matrices of the modes are invertible, the modes can also be
+/// simulated backward, from the states that complete a solution. This file
+/// provides a bidirectional search, which expands partial solutions forward
+/// from the initial state and backward from a sample of the target manifold,
+/// each for about half of the depth, and joins the halves whose states meet.
+/// Since the number of partial solutions grows exponentially with the depth,
+/// halving it shrinks the search dramatically. It includes:
+/// - The `BidirectionalParameters` structure, with the terminal states and the
+///   depth of each direction.
+/// - The `StateGrid` class, a hash grid indexing solutions by state, which only
+///   keeps the solutions of a cell that are not dominated by the others.
+/// - The `sample_target_manifold` function, which samples the states where the
+///   progress coordinate reaches the target.
+/// - The `perform_bidirectional_search` function, which runs the search.
+///
+/// The halves are joined when their states agree within a tolerance, hence,
+/// every joined sequence is re-simulated forward, and the front only contains
+/// the exact resources of complete solutions.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/mode_execution.hpp"
+#include "flexman/core/pareto_front.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/linear/common.hpp"
+#include "flexman/linear/kernels.hpp"
+#include "flexman/linear/manager.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+#include "flexman/search/metrics.hpp"
+
+namespace flexman
+{
+namespace linear
+{
+
+/// @brief The parameters of the bidirectional search.
+///
+/// @tparam NS The number of states.
+/// @tparam Scalar The scalar type.
+template <std::size_t NS, typename Scalar = double>
+struct BidirectionalParameters {
+    /// @brief The states the backward expansion starts from, which should lie
+    /// on the target manifold (see `sample_target_manifold`).
+    std::vector<Vector<Scalar, NS>> terminal_states;
+    /// @brief The size of the cells of the state index, per component. Two
+    /// halves are joined when their states differ by at most a cell in every
+    /// component.
+    Vector<Scalar, NS> tolerance{};
+    /// @brief The number of steps of each level of the expansions.
+    unsigned steps_per_level = 16;
+    /// @brief The number of levels expanded forward, from the initial state.
+    unsigned forward_levels  = 4;
+    /// @brief The number of levels expanded backward, from the terminal states.
+    unsigned backward_levels = 4;
+    /// @brief Drops the backward partial solutions whose state leaves the box
+    /// bounding the forward ones, enlarged by the tolerance. The backward
+    /// dynamics of stable modes are unstable, and such states rarely return.
+    bool bound_backward      = true;
+};
+
+/// @brief A hash grid, indexing solutions by their state.
+///
+/// @details The state space is divided in cells of fixed size, and each cell
+/// only keeps the solutions whose resources are not dominated by the ones of
+/// the other solutions of the cell. Since the solutions of a cell have almost
+/// the same state, this prunes the partial solutions that reach the same
+/// region at a higher cost.
+///
+/// @tparam NS The number of states.
+/// @tparam Scalar The scalar type.
+template <std::size_t NS, typename Scalar = double>
+class StateGrid
+{
+public:
+    /// @brief The type of the state.
+    using state_t    = Vector<Scalar, NS>;
+    /// @brief The type of the solutions.
+    using solution_t = flexman::core::Solution<state_t, Resources<Scalar>>;
+
+    /// @brief Constructs an empty grid.
+    ///
+    /// @param _cell_size The size of the cells, per component.
+    explicit StateGrid(const state_t &_cell_size)
+        : cell_size(_cell_size)
+    {
+        for (const auto size : cell_size) {
+            if (!(size > Scalar(0))) {
+                throw std::invalid_argument("the cells of the state grid must have a positive size");
+            }
+        }
+    }
+
+    /// @brief Inserts a solution in the cell of its state, unless a solution of
+    /// the cell has no worse resources. The solutions of the cell it dominates
+    /// are removed.
+    ///
+    /// @param solution The solution to insert.
+    ///
+    /// @return True if the solution was inserted, false otherwise.
+    auto insert(const solution_t &solution) -> bool
+    {
+        auto &cell = cells[this->key_of(solution.state)];
+        for (const auto &other : cell) {
+            if (other.resources <= solution.resources) {
+                return false;
+            }
+        }
+        const std::size_t before = cell.size();
+        cell.erase(
+            std::remove_if(
+                cell.begin(), cell.end(),
+                [&solution](const solution_t &other) { return solution.resources <= other.resources; }),
+            cell.end());
+        count -= before - cell.size();
+        cell.push_back(solution);
+        ++count;
+        // Grow the bounding box.
+        for (std::size_t i = 0; i < NS; ++i) {
+            lower[i] = (count == 1) ? solution.state[i] : std::min(lower[i], solution.state[i]);
+            upper[i] = (count == 1) ? solution.state[i] : std::max(upper[i], solution.state[i]);
+        }
+        return true;
+    }
+
+    /// @brief Checks if a state lies within the box bounding the states of all
+    /// the solutions inserted so far, enlarged by a cell in every component.
+    ///
+    /// @param state The state.
+    ///
+    /// @return True if the state lies within the box, false otherwise.
+    auto within_bounds(const state_t &state) const -> bool
+    {
+        for (std::size_t i = 0; i < NS; ++i) {
+            if ((state[i] < lower[i] - cell_size[i]) || (state[i] > upper[i] + cell_size[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Visits the solutions whose state differs from the given one by
+    /// at most a cell in every component.
+    ///
+    /// @param state The state.
+    /// @param visitor The function called with each solution.
+    template <typename Visitor>
+    void visit_neighbours(const state_t &state, Visitor &&visitor) const
+    {
+        const key_t center = this->key_of(state);
+        // Enumerate the offsets of the neighbouring cells, in {-1, 0, 1}^NS.
+        std::array<std::int64_t, NS> offset;
+        offset.fill(-1);
+        while (true) {
+            key_t key;
+            for (std::size_t i = 0; i < NS; ++i) {
+                key[i] = center[i] + offset[i];
+            }
+            auto it = cells.find(key);
+            if (it != cells.end()) {
+                for (const auto &solution : it->second) {
+                    bool near = true;
+                    for (std::size_t i = 0; (i < NS) && near; ++i) {
+                        near = std::abs(solution.state[i] - state[i]) <= cell_size[i];
+                    }
+                    if (near) {
+                        visitor(solution);
+                    }
+                }
+            }
+            // Move to the next offset.
+            std::size_t i = 0;
+            for (; i < NS; ++i) {
+                if (offset[i] < 1) {
+                    ++offset[i];
+                    break;
+                }
+                offset[i] = -1;
+            }
+            if (i == NS) {
+                break;
+            }
+        }
+    }
+
+    /// @brief Visits all the solutions of the grid.
+    ///
+    /// @param visitor The function called with each solution.
+    template <typename Visitor>
+    void visit(Visitor &&visitor) const
+    {
+        for (const auto &[key, cell] : cells) {
+            for (const auto &solution : cell) {
+                visitor(solution);
+            }
+        }
+    }
+
+    /// @brief Returns the number of solutions in the grid.
+    ///
+    /// @return The number of solutions.
+    auto size() const noexcept -> std::size_t { return count; }
+
+private:
+    /// @brief The coordinates of a cell.
+    using key_t = std::array<std::int64_t, NS>;
+
+    /// @brief Hashes the coordinates of a cell.
+    struct key_hash_t {
+        auto operator()(const key_t &key) const noexcept -> std::size_t
+        {
+            std::size_t hash = 0;
+            for (const auto coordinate : key) {
+                hash ^= std::hash<std::int64_t>{}(coordinate) + std::size_t{0x9e3779b9} + (hash << 6U) + (hash >> 2U);
+            }
+            return hash;
+        }
+    };
+
+    /// @brief Computes the cell of a state.
+    ///
+    /// @param state The state.
+    ///
+    /// @return The coordinates of the cell.
+    auto key_of(const state_t &state) const -> key_t
+    {
+        // Clamp the coordinates, so that far away states do not overflow.
+        constexpr double limit = 1e15;
+        key_t key;
+        for (std::size_t i = 0; i < NS; ++i) {
+            const double coordinate = std::floor(static_cast<double>(state[i] / cell_size[i]));
+            key[i]                  = static_cast<std::int64_t>(std::clamp(coordinate, -limit, limit));
+        }
+        return key;
+    }
+
+    /// @brief The size of the cells, per component.
+    state_t cell_size;
+    /// @brief The solutions of each non-empty cell.
+    std::unordered_map<key_t, std::vector<solution_t>, key_hash_t> cells;
+    /// @brief The number of solutions.
+    std::size_t count = 0;
+    /// @brief The lower corner of the box bounding the inserted states.
+    state_t lower{};
+    /// @brief The upper corner of the box bounding the inserted states.
+    state_t upper{};
+};
+
+/// @brief Samples the target manifold, i.e., the states whose progress
+/// coordinate is the one of the target.
+///
+/// @details The other components are sampled on a regular grid between the
+/// given bounds; the bounds of the progress coordinate are ignored.
+///
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam Scalar The scalar type.
+///
+/// @param manager The manager.
+/// @param lower The lower bounds of the components.
+/// @param upper The upper bounds of the components.
+/// @param samples The number of samples per component, a single sample takes
+/// the midpoint of the bounds.
+///
+/// @return The sampled states.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+auto sample_target_manifold(
+    const LinearDiscreteManager<NS, NI, Scalar> &manager,
+    const Vector<Scalar, NS> &lower,
+    const Vector<Scalar, NS> &upper,
+    unsigned samples) -> std::vector<Vector<Scalar, NS>>
+{
+    if (samples == 0) {
+        throw std::invalid_argument("samples must be greater than 0");
+    }
+    if (manager.progress_index >= NS) {
+        throw std::invalid_argument("progress_index is out of range");
+    }
+
+    // The value of each component at a given sample index.
+    auto value_at = [&](std::size_t component, unsigned index) {
+        if (samples == 1) {
+            return (lower[component] + upper[component]) / Scalar(2);
+        }
+        const auto relative = static_cast<Scalar>(index) / static_cast<Scalar>(samples - 1);
+        return lower[component] + relative * (upper[component] - lower[component]);
+    };
+
+    std::vector<Vector<Scalar, NS>> states;
+    std::array<unsigned, NS> index{};
+    while (true) {
+        Vector<Scalar, NS> state{};
+        for (std::size_t i = 0; i < NS; ++i) {
+            state[i] = (i == manager.progress_index) ? manager.target_state[i] : value_at(i, index[i]);
+        }
+        states.emplace_back(state);
+        // Move to the next sample, skipping the progress coordinate.
+        std::size_t i = 0;
+        for (; i < NS; ++i) {
+            if ((i != manager.progress_index) && (index[i] + 1 < samples)) {
+                ++index[i];
+                break;
+            }
+            index[i] = 0;
+        }
+        if (i == NS) {
+            break;
+        }
+    }
+    return states;
+}
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief A mode prepared for the backward simulation.
+template <std::size_t NS, typename Scalar>
+struct reverse_mode_t {
+    /// @brief The identifier of the mode.
+    flexman::core::ModeId id;
+    /// @brief The inverse of the state matrix.
+    Matrix<Scalar, NS, NS> inverse;
+    /// @brief The contribution of the input to the state, B * u.
+    Vector<Scalar, NS> input_contribution;
+    /// @brief The energy spent per step is the dot product of the state reached
+    /// by the step with this row.
+    Vector<Scalar, NS> energy_row;
+};
+
+/// @brief Prepares the modes for the backward simulation.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+auto reverse_modes(const LinearDiscreteManager<NS, NI, Scalar> &manager, const std::vector<Mode<NS, NI, Scalar>> &modes)
+    -> std::vector<reverse_mode_t<NS, Scalar>>
+{
+    std::vector<reverse_mode_t<NS, Scalar>> reversed;
+    reversed.reserve(modes.size());
+    for (const auto &mode : modes) {
+        // Invert in double precision, whatever the scalar type.
+        const auto inverse = linear::invert(linear::cast<double>(mode.system.A));
+        if (!inverse) {
+            throw std::invalid_argument("the state matrix of a mode is singular, it cannot be simulated backward");
+        }
+        const auto u = linear::cast<double>(mode.input);
+        reversed.push_back(reverse_mode_t<NS, Scalar>{
+            .id                 = mode.id,
+            .inverse            = linear::cast<Scalar>(*inverse),
+            .input_contribution = linear::cast<Scalar>(linear::multiply(linear::cast<double>(mode.system.B), u)),
+            .energy_row         = linear::cast<Scalar>(linear::scale(
+                linear::multiply(linear::cast<double>(manager.energy_weights), u), manager.time_delta)),
+        });
+    }
+    return reversed;
+}
+
+/// @brief Simulates a partial solution backward, by a number of steps of a
+/// mode. The sequences of the backward partial solutions are kept in reverse
+/// order, hence, the steps are appended to it.
+///
+/// @return The extended solution, or nothing if it passes through a complete
+/// state, since the forward simulation would have stopped there, or if it
+/// diverges.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+auto step_backward(
+    const LinearDiscreteManager<NS, NI, Scalar> &manager,
+    const reverse_mode_t<NS, Scalar> &mode,
+    unsigned steps,
+    flexman::core::Solution<Vector<Scalar, NS>, Resources<Scalar>> solution)
+    -> std::optional<flexman::core::Solution<Vector<Scalar, NS>, Resources<Scalar>>>
+{
+    const auto dt = static_cast<Scalar>(manager.time_delta);
+    for (unsigned step = 0; step < steps; ++step) {
+        // The energy of a step depends on the state it reaches, i.e., the
+        // current one; then, x = A^-1 * (x' - B * u).
+        solution.resources.energy += linear::dot(solution.state, mode.energy_row);
+        solution.resources.time += dt;
+        solution.state = linear::multiply(
+            mode.inverse, linear::add(solution.state, linear::scale(mode.input_contribution, Scalar(-1))));
+        if (manager.is_complete(solution)) {
+            return std::nullopt;
+        }
+    }
+    for (const auto component : solution.state) {
+        if (!std::isfinite(static_cast<double>(component))) {
+            return std::nullopt;
+        }
+    }
+    solution.distance = manager.distance(solution);
+    flexman::core::detail::add_mode_execution_to_sequence(mode.id, solution.sequence, steps);
+    return solution;
+}
+
+/// @brief Completes a forward half with the sequence of a backward half, by
+/// simulating it forward. If the sequence ends before completing, its last
+/// mode is executed until the solution completes.
+///
+/// @return The complete solution, or nothing if it cannot be completed within
+/// the maximum simulated time.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+auto replay_suffix(
+    const LinearDiscreteManager<NS, NI, Scalar> &manager,
+    const std::vector<Mode<NS, NI, Scalar>> &modes,
+    unsigned steps_per_level,
+    flexman::core::Solution<Vector<Scalar, NS>, Resources<Scalar>> solution,
+    const std::vector<flexman::core::ModeExecution> &suffix)
+    -> std::optional<flexman::core::Solution<Vector<Scalar, NS>, Resources<Scalar>>>
+{
+    for (const auto &execution : suffix) {
+        solution = flexman::search::simulate_mode(
+            &manager, modes[execution.mode], static_cast<unsigned>(execution.times), std::move(solution));
+        if (manager.is_complete(solution)) {
+            return solution;
+        }
+    }
+    const auto &last = modes[suffix.back().mode];
+    while (static_cast<double>(solution.resources.time) < manager.time_max) {
+        solution = flexman::search::simulate_mode(&manager, last, steps_per_level, std::move(solution));
+        if (manager.is_complete(solution)) {
+            return solution;
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief Orders sequences lexicographically, to detect duplicated joins.
+struct sequence_less_t {
+    auto operator()(
+        const std::vector<flexman::core::ModeExecution> &lhs,
+        const std::vector<flexman::core::ModeExecution> &rhs) const -> bool
+    {
+        return std::lexicographical_compare(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const auto &a, const auto &b) {
+                return (a.mode < b.mode) || ((a.mode == b.mode) && (a.times < b.times));
+            });
+    }
+};
+
+} // namespace detail
+
+/// @brief Performs a meet-in-the-middle search.
+///
+/// @details The search proceeds in three phases:
+/// 1. Forward: the partial solutions are extended from the initial state with
+///    every mode, one level of `steps_per_level` steps at a time, and indexed
+///    in a `StateGrid`. The solutions that complete are kept.
+/// 2. Backward: the terminal states are simulated backward with every mode,
+///    with the same levels, and indexed in another `StateGrid`. A backward
+///    partial solution holds the sequence leading from its state to the
+///    target, in reverse order, and the resources spent along it.
+/// 3. Join: each backward partial solution is joined with the forward ones
+///    whose state agrees within the tolerance, the joined sequence is
+///    re-simulated forward from the end of the forward half, and the complete
+///    solutions are filtered for dominance.
+///
+/// Each direction covers only part of the depth of a sequence, and the grids
+/// merge the partial solutions reaching the same region, hence, much fewer
+/// partial solutions are simulated than by a forward search of the same depth.
+/// The quality of the front depends on the density of the terminal states and
+/// on the tolerance, which trade the number of joins for their accuracy.
+///
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam Scalar The scalar type.
+///
+/// @param manager Pointer to the manager.
+/// @param modes The modes, indexed by their id, whose state matrices must be invertible.
+/// @param parameters The parameters of the search.
+///
+/// @return The Pareto front of the complete solutions.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+auto perform_bidirectional_search(
+    const LinearDiscreteManager<NS, NI, Scalar> *manager,
+    const std::vector<Mode<NS, NI, Scalar>> &modes,
+    const BidirectionalParameters<NS, Scalar> &parameters)
+    -> flexman::core::ParetoFront<Vector<Scalar, NS>, Resources<Scalar>>
+{
+    using solution_t = flexman::core::Solution<Vector<Scalar, NS>, Resources<Scalar>>;
+
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    if (modes.empty()) {
+        throw std::invalid_argument("modes vector is empty");
+    }
+    for (std::size_t i = 0; i < modes.size(); ++i) {
+        if (modes[i].id != i) {
+            throw std::invalid_argument("modes must be indexed by their id");
+        }
+    }
+    if (parameters.steps_per_level == 0) {
+        throw std::invalid_argument("steps_per_level must be greater than 0");
+    }
+    if (parameters.terminal_states.empty()) {
+        throw std::invalid_argument("terminal_states is empty");
+    }
+
+    // A stopwatch, to check runtime.
+    timelib::Timer global_timer;
+    if (manager->timeout) {
+        global_timer.set_timeout(manager->timeout);
+    }
+    global_timer.start();
+
+    const auto reversed = detail::reverse_modes(*manager, modes);
+    const auto time_max = static_cast<Scalar>(manager->time_max);
+
+    // The complete solutions.
+    std::vector<solution_t> solutions;
+
+    // Expand forward, from the initial state.
+    StateGrid<NS, Scalar> forward(parameters.tolerance);
+    std::vector<solution_t> frontier{
+        solution_t{
+            .sequence  = {},
+            .state     = manager->initial_state,
+            .resources = Resources<Scalar>(),
+            .distance  = std::numeric_limits<double>::max(),
+        },
+    };
+    forward.insert(frontier.front());
+    for (unsigned level = 0; (level < parameters.forward_levels) && !frontier.empty(); ++level) {
+        auto extended = flexman::search::extend_solutions<flexman::search::SwitchingMode::Free>(
+            manager, modes, parameters.steps_per_level, frontier, global_timer);
+        std::vector<solution_t> complete;
+        std::vector<solution_t> partial;
+        flexman::search::split_complete_partial(manager, extended, complete, partial);
+        flexman::search::move_elements(complete, solutions);
+        frontier.clear();
+        for (auto &solution : partial) {
+            if ((solution.resources.time <= time_max) && forward.insert(solution)) {
+                frontier.emplace_back(std::move(solution));
+            }
+        }
+        qdebug(logging::search, "Forward level %2u: %8u partial solutions.\n", level + 1, frontier.size());
+        if (global_timer.has_timeout()) {
+            qwarning(logging::search, "Timer expired while expanding forward.\n");
+            break;
+        }
+    }
+
+    // Expand backward, from the terminal states.
+    StateGrid<NS, Scalar> backward(parameters.tolerance);
+    frontier.clear();
+    for (const auto &state : parameters.terminal_states) {
+        frontier.push_back(
+            solution_t{
+                .sequence  = {},
+                .state     = state,
+                .resources = Resources<Scalar>(),
+                .distance  = 0.0,
+            });
+    }
+    for (unsigned level = 0; (level < parameters.backward_levels) && !frontier.empty(); ++level) {
+        std::vector<solution_t> next;
+        for (const auto &solution : frontier) {
+            for (const auto &mode : reversed) {
+                auto previous = detail::step_backward(*manager, mode, parameters.steps_per_level, solution);
+                if (!previous || (previous->resources.time > time_max)) {
+                    continue;
+                }
+                if (parameters.bound_backward && !forward.within_bounds(previous->state)) {
+                    continue;
+                }
+                if (backward.insert(*previous)) {
+                    next.emplace_back(std::move(*previous));
+                }
+            }
+        }
+        frontier = std::move(next);
+        qdebug(logging::search, "Backward level %2u: %8u partial solutions.\n", level + 1, frontier.size());
+        if (global_timer.has_timeout()) {
+            qwarning(logging::search, "Timer expired while expanding backward.\n");
+            break;
+        }
+    }
+
+    // Join the halves whose states meet.
+    std::set<std::vector<flexman::core::ModeExecution>, detail::sequence_less_t> joined;
+    std::size_t joins = 0;
+    backward.visit([&](const solution_t &suffix) {
+        if (global_timer.has_timeout()) {
+            return;
+        }
+        forward.visit_neighbours(suffix.state, [&](const solution_t &prefix) {
+            if (prefix.resources.time + suffix.resources.time > time_max) {
+                return;
+            }
+            // The sequence of the backward half is in reverse order.
+            const std::vector<flexman::core::ModeExecution> tail(suffix.sequence.rbegin(), suffix.sequence.rend());
+            auto sequence = prefix.sequence;
+            for (const auto &execution : tail) {
+                flexman::core::detail::add_mode_execution_to_sequence(execution.mode, sequence, execution.times);
+            }
+            if (!joined.insert(std::move(sequence)).second) {
+                return;
+            }
+            ++joins;
+            if (auto solution = detail::replay_suffix(*manager, modes, parameters.steps_per_level, prefix, tail)) {
+                solutions.emplace_back(std::move(*solution));
+            }
+        });
+    });
+
+    // Keep the non-dominated solutions.
+    const std::size_t complete = solutions.size();
+    flexman::search::remove_dominated_solutions<flexman::search::SearchAlgorithm::Exhaustive>(manager, solutions);
+    flexman::search::remove_duplicate_solutions(solutions);
+
+    auto pareto_front = flexman::core::ParetoFront<Vector<Scalar, NS>, Resources<Scalar>>{
+        .solutions           = std::move(solutions),
+        .step_length         = manager->time_delta * static_cast<double>(parameters.steps_per_level),
+        .steps_per_iteration = parameters.steps_per_level,
+        .iteration           = parameters.forward_levels + parameters.backward_levels,
+        .runtime             = global_timer.elapsed().count(),
+        .hypervolume         = 0.0,
+    };
+    if (!pareto_front.solutions.empty()) {
+        pareto_front.hypervolume = flexman::search::hypervolume(
+            pareto_front.solutions, flexman::search::reference_point(pareto_front.solutions));
+    }
+
+    qinfo(
+        logging::search,
+        "Bidirectional search: %u forward and %u backward partial solutions, %u joins, %u complete solutions, %u "
+        "in the front (%.3f s).\n",
+        forward.size(), backward.size(), joins, complete, pareto_front.solutions.size(), pareto_front.runtime);
+
+    return pareto_front;
+}
+
+} // namespace linear
+} // namespace flexman
@@ -0,0 +1,194 @@
+/// @file common.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines the data structures of the linear managers.
+///
+/// @details
+/// This file provides the types shared by the managers of discrete-time linear
+/// time-invariant systems, including:
+/// - The `System` structure, holding the state and input matrices of a mode,
+///   and its description for the fingerprints of the search requests.
+/// - The `Mode` alias, a mode with a linear system and a fixed input.
+/// - The `Resources` structure, which tracks the energy and the time spent,
+///   together with its comparison and output operators.
+///
+/// All of them are templated on the scalar type, which is either `double` or
+/// `float`. Single precision halves the memory taken by the partial solutions,
+/// and doubles the width of the vectorized kernels, at the cost of accuracy;
+/// see `precision.hpp` for how to verify its results.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "flexman/core/fingerprint.hpp"
+#include "flexman/core/mode.hpp"
+#include "flexman/linear/kernels.hpp"
+
+namespace flexman
+{
+namespace linear
+{
+
+/// @brief A discrete-time linear time-invariant system, x' = A * x + B * u.
+///
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam Scalar The scalar type.
+template <std::size_t NS, std::size_t NI, typename Scalar = double>
+struct System {
+    /// @brief The state matrix.
+    Matrix<Scalar, NS, NS> A{};
+    /// @brief The input matrix.
+    Matrix<Scalar, NS, NI> B{};
+};
+
+/// @brief Appends a description of a system to a fingerprint (see `flexman::core::append_value`).
+///
+/// @param key the fingerprint.
+/// @param system the system.
+///
+/// @return True, both matrices can always be described.
+template <std::size_t NS, std::size_t NI, typename Scalar>
+inline auto append_fields(std::string &key, const System<NS, NI, Scalar> &system) -> bool
+{
+    return flexman::core::append_value(key, system.A) && flexman::core::append_value(key, system.B);
+}
+
+/// @brief A mode driving a linear system with a fixed input.
+///
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam Scalar The scalar type.
+template <std::size_t NS, std::size_t NI, typename Scalar = double>
+using Mode = flexman::core::Mode<System<NS, NI, Scalar>, Vector<Scalar, NI>>;
+
+/// @brief The resources spent by a solution of a linear manager.
+///
+/// @tparam Scalar The scalar type.
+template <typename Scalar = double>
+struct Resources {
+    static_assert(std::is_floating_point_v<Scalar>, "the scalar type must be a floating point type");
+
+    /// @brief Energy spent so far.
+    Scalar energy{};
+    /// @brief Time spent so far.
+    Scalar time{};
+};
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief The relative tolerance of the comparisons, coarser in single precision.
+template <typename Scalar>
+inline constexpr Scalar tolerance = std::is_same_v<Scalar, float> ? Scalar(1e-05) : Scalar(1e-09);
+
+/// @brief Checks if two values are equal, up to a relative tolerance.
+///
+/// @param a The first value.
+/// @param b The second value.
+///
+/// @return True if the values are approximately equal, false otherwise.
+template <typename Scalar>
+inline auto approximately_equal(Scalar a, Scalar b) noexcept -> bool
+{
+    return std::abs(a - b) <= tolerance<Scalar> * std::max({Scalar(1), std::abs(a), std::abs(b)});
+}
+
+/// @brief Checks if a value is lower than or equal to another, up to a relative tolerance.
+///
+/// @param a The first value.
+/// @param b The second value.
+///
+/// @return True if the first value is approximately lower than or equal to the second.
+template <typename Scalar>
+inline auto approximately_lesser_than_equal(Scalar a, Scalar b) noexcept -> bool
+{
+    return (a < b) || approximately_equal(a, b);
+}
+
+} // namespace detail
+
+/// @brief Checks if two resources are approximately equal.
+///
+/// @param lhs The left-hand side resources.
+/// @param rhs The right-hand side resources.
+///
+/// @return True if both the energy and the time are approximately equal.
+template <typename Scalar>
+inline auto operator==(const Resources<Scalar> &lhs, const Resources<Scalar> &rhs) noexcept -> bool
+{
+    return detail::approximately_equal(lhs.energy, rhs.energy) && detail::approximately_equal(lhs.time, rhs.time);
+}
+
+/// @brief Checks if two resources differ.
+///
+/// @param lhs The left-hand side resources.
+/// @param rhs The right-hand side resources.
+///
+/// @return True if either the energy or the time differ.
+template <typename Scalar>
+inline auto operator!=(const Resources<Scalar> &lhs, const Resources<Scalar> &rhs) noexcept -> bool
+{
+    return !(lhs == rhs);
+}
+
+/// @brief Checks if some resources are no worse than others in both objectives.
+///
+/// @param lhs The left-hand side resources.
+/// @param rhs The right-hand side resources.
+///
+/// @return True if both the energy and the time of lhs are lower than or equal to the ones of rhs.
+template <typename Scalar>
+inline auto operator<=(const Resources<Scalar> &lhs, const Resources<Scalar> &rhs) noexcept -> bool
+{
+    return detail::approximately_lesser_than_equal(lhs.energy, rhs.energy) &&
+           detail::approximately_lesser_than_equal(lhs.time, rhs.time);
+}
+
+/// @brief Orders resources by energy first, and time second.
+///
+/// @param lhs The left-hand side resources.
+/// @param rhs The right-hand side resources.
+///
+/// @return True if lhs comes before rhs.
+template <typename Scalar>
+inline auto operator<(const Resources<Scalar> &lhs, const Resources<Scalar> &rhs) noexcept -> bool
+{
+    if (!detail::approximately_equal(lhs.energy, rhs.energy)) {
+        return lhs.energy < rhs.energy;
+    }
+    return lhs.time < rhs.time;
+}
+
+/// @brief Outputs the resources to an output stream.
+///
+/// @param lhs The output stream to write to.
+/// @param rhs The resources to output.
+///
+/// @return A reference to the output stream.
+template <typename Scalar>
+inline auto operator<<(std::ostream &lhs, const Resources<Scalar> &rhs) -> std::ostream &
+{
+    lhs << std::fixed;
+    lhs << "(";
+    lhs << std::setprecision(3) << std::setw(6) << std::right << rhs.time << ",";
+    lhs << std::setprecision(3) << std::setw(8) << std::right << rhs.energy;
+    lhs << ")";
+    return lhs;
+}
+
+} // namespace linear
+} // namespace flexman
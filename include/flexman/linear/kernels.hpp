@@ -0,0 +1,376 @@
+/// @file kernels.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements small fixed-size linear algebra kernels.
+///
+/// @details
+/// This file provides the vector and matrix types used by the linear managers,
+/// and the kernels operating on them. The sizes are known at compile time, and
+/// every kernel is unrolled through index sequences, so that the compiler can
+/// keep the operands in registers and vectorize the arithmetic. It includes:
+/// - The `Vector` and `Matrix` aliases, stored row-major in `std::array`.
+/// - The `dot`, `add`, `scale`, `multiply` and `multiply_add` kernels.
+/// - The `identity`, `transpose`, `cast` and `invert` helpers.
+/// - The `stacked_dot` and `stacked_affine` kernels, which apply the same
+///   operation of several systems, stacked with the system index innermost, to
+///   the same vector, so that the arithmetic is vectorized across systems.
+///
+/// The kernels are templated on the scalar type, so that they work both in
+/// double and in single precision.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace flexman
+{
+
+/// @brief Contains the managers and kernels for linear time-invariant systems.
+namespace linear
+{
+
+/// @brief A fixed-size column vector.
+///
+/// @tparam T The type of the elements.
+/// @tparam N The number of elements.
+template <typename T, std::size_t N>
+using Vector = std::array<T, N>;
+
+/// @brief A fixed-size matrix, stored row-major.
+///
+/// @tparam T The type of the elements.
+/// @tparam R The number of rows.
+/// @tparam C The number of columns.
+template <typename T, std::size_t R, std::size_t C>
+using Matrix = std::array<std::array<T, C>, R>;
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Unrolled dot product.
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto dot(const Vector<T, N> &a, const Vector<T, N> &b, std::index_sequence<I...>) noexcept -> T
+{
+    return (... + (a[I] * b[I]));
+}
+
+/// @brief Unrolled element-wise sum.
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto add(const Vector<T, N> &a, const Vector<T, N> &b, std::index_sequence<I...>) noexcept -> Vector<T, N>
+{
+    return Vector<T, N>{(a[I] + b[I])...};
+}
+
+/// @brief Unrolled scaling.
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto scale(const Vector<T, N> &a, T factor, std::index_sequence<I...>) noexcept -> Vector<T, N>
+{
+    return Vector<T, N>{(a[I] * factor)...};
+}
+
+/// @brief Unrolled matrix-vector product, one dot product per row.
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr auto multiply(const Matrix<T, R, C> &A, const Vector<T, C> &x, std::index_sequence<I...>) noexcept
+    -> Vector<T, R>
+{
+    return Vector<T, R>{detail::dot(A[I], x, std::make_index_sequence<C>{})...};
+}
+
+/// @brief Unrolled extraction of a column.
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr auto column(const Matrix<T, R, C> &A, std::size_t c, std::index_sequence<I...>) noexcept -> Vector<T, R>
+{
+    return Vector<T, R>{A[I][c]...};
+}
+
+/// @brief Unrolled transposition, one column per row of the result.
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr auto transpose(const Matrix<T, R, C> &A, std::index_sequence<I...>) noexcept -> Matrix<T, C, R>
+{
+    return Matrix<T, C, R>{detail::column(A, I, std::make_index_sequence<R>{})...};
+}
+
+/// @brief Builds the I-th row of the identity.
+template <typename T, std::size_t N, std::size_t Row, std::size_t... I>
+constexpr auto identity_row(std::index_sequence<I...>) noexcept -> Vector<T, N>
+{
+    return Vector<T, N>{(I == Row ? T(1) : T(0))...};
+}
+
+/// @brief Unrolled conversion of the scalar type.
+template <typename To, typename From, std::size_t N, std::size_t... I>
+constexpr auto cast(const Vector<From, N> &a, std::index_sequence<I...>) noexcept -> Vector<To, N>
+{
+    return Vector<To, N>{static_cast<To>(a[I])...};
+}
+
+/// @brief Unrolled dot product with a row of stacked systems, whose components
+/// are count values apart.
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto stacked_dot(const T *row, std::size_t count, const Vector<T, N> &x, std::index_sequence<I...>) noexcept
+    -> T
+{
+    return (... + (row[I * count] * x[I]));
+}
+
+/// @brief Unrolled identity.
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto identity(std::index_sequence<I...>) noexcept -> Matrix<T, N, N>
+{
+    return Matrix<T, N, N>{detail::identity_row<T, N, I>(std::make_index_sequence<N>{})...};
+}
+
+} // namespace detail
+
+/// @brief Computes the dot product of two vectors.
+///
+/// @param a The first vector.
+/// @param b The second vector.
+///
+/// @return The dot product.
+template <typename T, std::size_t N>
+constexpr auto dot(const Vector<T, N> &a, const Vector<T, N> &b) noexcept -> T
+{
+    static_assert(N > 0, "vectors must not be empty");
+    return detail::dot(a, b, std::make_index_sequence<N>{});
+}
+
+/// @brief Computes the element-wise sum of two vectors.
+///
+/// @param a The first vector.
+/// @param b The second vector.
+///
+/// @return The sum.
+template <typename T, std::size_t N>
+constexpr auto add(const Vector<T, N> &a, const Vector<T, N> &b) noexcept -> Vector<T, N>
+{
+    return detail::add(a, b, std::make_index_sequence<N>{});
+}
+
+/// @brief Scales a vector.
+///
+/// @param a The vector.
+/// @param factor The scaling factor.
+///
+/// @return The scaled vector.
+template <typename T, std::size_t N>
+constexpr auto scale(const Vector<T, N> &a, T factor) noexcept -> Vector<T, N>
+{
+    return detail::scale(a, factor, std::make_index_sequence<N>{});
+}
+
+/// @brief Computes the product between a matrix and a vector.
+///
+/// @param A The matrix.
+/// @param x The vector.
+///
+/// @return The product A * x.
+template <typename T, std::size_t R, std::size_t C>
+constexpr auto multiply(const Matrix<T, R, C> &A, const Vector<T, C> &x) noexcept -> Vector<T, R>
+{
+    static_assert(C > 0, "matrices must not be empty");
+    return detail::multiply(A, x, std::make_index_sequence<R>{});
+}
+
+/// @brief Computes the affine update A * x + B * u of a state-space model.
+///
+/// @param A The state matrix.
+/// @param x The state.
+/// @param B The input matrix.
+/// @param u The input.
+///
+/// @return The updated state.
+template <typename T, std::size_t NS, std::size_t NI>
+constexpr auto multiply_add(
+    const Matrix<T, NS, NS> &A,
+    const Vector<T, NS> &x,
+    const Matrix<T, NS, NI> &B,
+    const Vector<T, NI> &u) noexcept -> Vector<T, NS>
+{
+    return linear::add(linear::multiply(A, x), linear::multiply(B, u));
+}
+
+/// @brief Computes the transpose of a matrix.
+///
+/// @param A The matrix.
+///
+/// @return The transpose of A.
+template <typename T, std::size_t R, std::size_t C>
+constexpr auto transpose(const Matrix<T, R, C> &A) noexcept -> Matrix<T, C, R>
+{
+    return detail::transpose(A, std::make_index_sequence<C>{});
+}
+
+/// @brief Computes the product between two matrices.
+///
+/// @param A The left matrix.
+/// @param B The right matrix.
+///
+/// @return The product A * B.
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr auto multiply(const Matrix<T, R, K> &A, const Matrix<T, K, C> &B) noexcept -> Matrix<T, R, C>
+{
+    // Each column of the product is A times a column of B, hence, each row of
+    // the transposed product is A times a row of the transposed B.
+    const Matrix<T, C, K> Bt = linear::transpose(B);
+    Matrix<T, C, R> Pt{};
+    for (std::size_t c = 0; c < C; ++c) {
+        Pt[c] = linear::multiply(A, Bt[c]);
+    }
+    return linear::transpose(Pt);
+}
+
+/// @brief Computes the element-wise sum of two matrices.
+///
+/// @param A The first matrix.
+/// @param B The second matrix.
+///
+/// @return The sum.
+template <typename T, std::size_t R, std::size_t C>
+constexpr auto add(const Matrix<T, R, C> &A, const Matrix<T, R, C> &B) noexcept -> Matrix<T, R, C>
+{
+    Matrix<T, R, C> sum{};
+    for (std::size_t r = 0; r < R; ++r) {
+        sum[r] = linear::add(A[r], B[r]);
+    }
+    return sum;
+}
+
+/// @brief Converts the scalar type of a vector.
+///
+/// @tparam To The target scalar type.
+///
+/// @param a The vector.
+///
+/// @return The converted vector.
+template <typename To, typename From, std::size_t N>
+constexpr auto cast(const Vector<From, N> &a) noexcept -> Vector<To, N>
+{
+    return detail::cast<To>(a, std::make_index_sequence<N>{});
+}
+
+/// @brief Converts the scalar type of a matrix.
+///
+/// @tparam To The target scalar type.
+///
+/// @param A The matrix.
+///
+/// @return The converted matrix.
+template <typename To, typename From, std::size_t R, std::size_t C>
+constexpr auto cast(const Matrix<From, R, C> &A) noexcept -> Matrix<To, R, C>
+{
+    Matrix<To, R, C> converted{};
+    for (std::size_t r = 0; r < R; ++r) {
+        converted[r] = linear::cast<To>(A[r]);
+    }
+    return converted;
+}
+
+/// @brief Builds the identity matrix.
+///
+/// @return The identity matrix.
+template <typename T, std::size_t N>
+constexpr auto identity() noexcept -> Matrix<T, N, N>
+{
+    return detail::identity<T, N>(std::make_index_sequence<N>{});
+}
+
+/// @brief Computes the inverse of a square matrix, by Gauss-Jordan elimination
+/// with partial pivoting.
+///
+/// @param A The matrix.
+/// @param epsilon The magnitude below which a pivot is considered null.
+///
+/// @return The inverse of A, or nothing if A is singular.
+template <typename T, std::size_t N>
+auto invert(const Matrix<T, N, N> &A, T epsilon = T(1e-12)) -> std::optional<Matrix<T, N, N>>
+{
+    Matrix<T, N, N> left    = A;
+    Matrix<T, N, N> inverse = linear::identity<T, N>();
+    for (std::size_t c = 0; c < N; ++c) {
+        // Pick the largest pivot of the column.
+        std::size_t pivot = c;
+        for (std::size_t r = c + 1; r < N; ++r) {
+            if (std::abs(left[r][c]) > std::abs(left[pivot][c])) {
+                pivot = r;
+            }
+        }
+        if (std::abs(left[pivot][c]) <= epsilon) {
+            return std::nullopt;
+        }
+        std::swap(left[c], left[pivot]);
+        std::swap(inverse[c], inverse[pivot]);
+        // Normalize the pivot row, and eliminate the column from the others.
+        const T factor = T(1) / left[c][c];
+        left[c]        = linear::scale(left[c], factor);
+        inverse[c]     = linear::scale(inverse[c], factor);
+        for (std::size_t r = 0; r < N; ++r) {
+            if (r != c) {
+                const T weight = -left[r][c];
+                left[r]        = linear::add(left[r], linear::scale(left[c], weight));
+                inverse[r]     = linear::add(inverse[r], linear::scale(inverse[c], weight));
+            }
+        }
+    }
+    return inverse;
+}
+
+/// @brief Computes the dot products between a vector and the rows of several
+/// systems, stacked with the system index innermost.
+///
+/// @details For each system m, out[m] = sum_c rows[c * count + m] * x[c] +
+/// offsets[m]. The products are accumulated in the same order of `dot`, hence,
+/// the results match the ones of the systems taken one at a time.
+///
+/// @param rows The stacked rows, N * count values.
+/// @param offsets The offsets, count values.
+/// @param x The vector.
+/// @param count The number of systems.
+/// @param out Where the count results are written.
+template <typename T, std::size_t N>
+inline void stacked_dot(const T *rows, const T *offsets, const Vector<T, N> &x, std::size_t count, T *out) noexcept
+{
+    static_assert(N > 0, "vectors must not be empty");
+    // A single pass over the systems, the components are unrolled, and
+    // consecutive systems are contiguous in memory.
+    for (std::size_t m = 0; m < count; ++m) {
+        out[m] = detail::stacked_dot(rows + m, count, x, std::make_index_sequence<N>{}) + offsets[m];
+    }
+}
+
+/// @brief Computes the affine maps of several systems applied to the same
+/// vector, stacked with the system index innermost.
+///
+/// @details For each system m and row r, out[r * count + m] = sum_c
+/// matrices[(r * N + c) * count + m] * x[c] + offsets[r * count + m].
+///
+/// @param matrices The stacked matrices, R * N * count values.
+/// @param offsets The stacked offsets, R * count values.
+/// @param x The vector.
+/// @param count The number of systems.
+/// @param out Where the R * count results are written.
+template <typename T, std::size_t R, std::size_t N>
+inline void stacked_affine(
+    const T *matrices,
+    const T *offsets,
+    const Vector<T, N> &x,
+    std::size_t count,
+    T *out) noexcept
+{
+    for (std::size_t r = 0; r < R; ++r) {
+        linear::stacked_dot(matrices + r * N * count, offsets + r * count, x, count, out + r * count);
+    }
+}
+
+} // namespace linear
+} // namespace flexman
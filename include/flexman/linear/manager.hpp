@@ -0,0 +1,543 @@
+/// @file manager.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines a ready-made manager for discrete-time linear systems.
+///
+/// @details
+/// This file provides the `LinearDiscreteManager` template class, a complete
+/// manager for modes that drive a discrete-time linear time-invariant system
+/// with a fixed input. Users only provide the modes, the energy functional and
+/// the progress coordinate, instead of implementing a manager by hand. Since
+/// the dynamics are linear, the manager enables the fast paths of the search:
+/// - A stride of the same mode is applied through a cached multi-step
+///   propagator, instead of step by step.
+/// - The step that completes a solution is located by checking only the
+///   progress coordinate of the intermediate states, through the cached rows
+///   of the propagator.
+/// - The completion point within the last step is computed analytically,
+///   instead of being searched by interpolation.
+/// - When a partial solution is extended under all the modes, the propagators
+///   of the modes are stacked with the mode index innermost, and the children
+///   are computed together, vectorizing across the modes.
+///
+/// The manager works either in double or in single precision. In both cases,
+/// the propagators are computed in double precision, and then converted.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flexman/core/fingerprint.hpp"
+#include "flexman/core/manager.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/linear/common.hpp"
+#include "flexman/linear/kernels.hpp"
+
+namespace flexman
+{
+namespace linear
+{
+
+/// @brief A manager for modes driving a discrete-time linear system.
+///
+/// @details At each step, the state is updated as x' = A * x + B * u, the
+/// energy increases by x'^T * W * u * dt, where W are the energy weights, and
+/// the time increases by dt. The distance from the target is measured along
+/// the progress coordinate, as target[p] - x[p], and a solution is complete
+/// when it falls below the threshold.
+///
+/// The propagators are cached by mode identifier and number of steps, hence,
+/// `clear_propagators` must be called whenever the modes, the time step or the
+/// energy weights change.
+///
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam Scalar The scalar type of states, modes and resources.
+template <std::size_t NS, std::size_t NI, typename Scalar = double>
+class LinearDiscreteManager
+    : public flexman::core::Manager<Vector<Scalar, NS>, Mode<NS, NI, Scalar>, Resources<Scalar>>
+{
+public:
+    /// @brief The type of the scalars.
+    using scalar_t    = Scalar;
+    /// @brief The type of the state.
+    using state_t     = Vector<Scalar, NS>;
+    /// @brief The type of the mode.
+    using mode_t      = Mode<NS, NI, Scalar>;
+    /// @brief The type of the resources.
+    using resources_t = Resources<Scalar>;
+    /// @brief The type of the solutions.
+    using solution_t  = flexman::core::Solution<state_t, resources_t>;
+
+    /// @brief The weights of the energy functional, the energy rate is x^T * W * u.
+    Matrix<Scalar, NS, NI> energy_weights{};
+    /// @brief The index of the state component measuring the progress towards the target.
+    std::size_t progress_index{};
+
+    /// @brief Default constructor.
+    LinearDiscreteManager() = default;
+
+    /// @brief Copy constructor, the propagators are not copied.
+    ///
+    /// @param other the other instance to copy.
+    LinearDiscreteManager(const LinearDiscreteManager &other)
+        : flexman::core::Manager<state_t, mode_t, resources_t>(other)
+        , energy_weights(other.energy_weights)
+        , progress_index(other.progress_index)
+    {
+        // Nothing to do.
+    }
+
+    /// @brief Copy assignment operator, the propagators are cleared.
+    ///
+    /// @param other the other instance to copy.
+    ///
+    /// @return a reference to this instance.
+    auto operator=(const LinearDiscreteManager &other) -> LinearDiscreteManager &
+    {
+        if (this != &other) {
+            flexman::core::Manager<state_t, mode_t, resources_t>::operator=(other);
+            energy_weights = other.energy_weights;
+            progress_index = other.progress_index;
+            this->clear_propagators();
+        }
+        return *this;
+    }
+
+    /// @brief Move constructor, the propagators are not moved.
+    ///
+    /// @param other the other instance to move.
+    LinearDiscreteManager(LinearDiscreteManager &&other) noexcept
+        : LinearDiscreteManager(static_cast<const LinearDiscreteManager &>(other))
+    {
+        // Nothing to do.
+    }
+
+    /// @brief Move assignment operator, the propagators are cleared.
+    ///
+    /// @param other the other instance to move.
+    ///
+    /// @return a reference to this instance.
+    auto operator=(LinearDiscreteManager &&other) noexcept -> LinearDiscreteManager &
+    {
+        return (*this = static_cast<const LinearDiscreteManager &>(other));
+    }
+
+    /// @brief Destructor.
+    ~LinearDiscreteManager() override = default;
+
+    /// @brief Discards the cached propagators.
+    void clear_propagators()
+    {
+        std::unique_lock<std::shared_mutex> lock(propagators_mutex);
+        propagators.clear();
+        stacked_propagators.clear();
+    }
+
+    void updated_solution(solution_t &solution, const mode_t &mode) const override
+    {
+        // Update the state.
+        solution.state = linear::multiply_add(mode.system.A, solution.state, mode.system.B, mode.input);
+        // Update the distance.
+        solution.distance = this->distance(solution);
+        // Update energy.
+        solution.resources.energy += linear::dot(solution.state, linear::multiply(energy_weights, mode.input)) *
+                                     static_cast<Scalar>(this->time_delta);
+        // Update time.
+        solution.resources.time += static_cast<Scalar>(this->time_delta);
+    }
+
+    auto is_complete(const solution_t &solution) const -> bool override
+    {
+        return this->distance(solution) < this->threshold;
+    }
+
+    auto distance(const solution_t &solution) const -> double override
+    {
+        return this->target_state[progress_index] - solution.state[progress_index];
+    }
+
+    auto is_strictly_better_than(const solution_t &first, const solution_t &second) const -> bool override
+    {
+        if (first.sequence == second.sequence) {
+            return false;
+        }
+        return this->is_complete(first) && (first.resources <= second.resources) &&
+               (first.resources != second.resources);
+    }
+
+    auto is_probably_better_than(const solution_t &first, const solution_t &second) const -> bool override
+    {
+        if (first.sequence == second.sequence) {
+            return false;
+        }
+        const auto first_distance  = this->distance(first);
+        const auto second_distance = this->distance(second);
+        if ((first_distance <= second_distance) && (first.resources <= second.resources)) {
+            return (first_distance < second_distance) || (first.resources < second.resources);
+        }
+        return false;
+    }
+
+    auto is_equal(const solution_t &first, const solution_t &second) const -> bool override
+    {
+        return (first.sequence == second.sequence) || (first.resources == second.resources);
+    }
+
+    auto interpolate_resources(const resources_t &r0, const resources_t &r1, double rel) const
+        -> resources_t override
+    {
+        // Linear interpolation.
+        const auto relative = static_cast<Scalar>(rel);
+        return resources_t{
+            .energy = r0.energy + relative * (r1.energy - r0.energy),
+            .time   = r0.time + relative * (r1.time - r0.time),
+        };
+    }
+
+    auto interpolate_state(const state_t &s0, const state_t &s1, double rel) const -> state_t override
+    {
+        const auto relative        = static_cast<Scalar>(rel);
+        state_t interpolated_state = s0;
+        for (std::size_t i = 0; i < NS; ++i) {
+            interpolated_state[i] = s0[i] + relative * (s1[i] - s0[i]);
+        }
+        return interpolated_state;
+    }
+
+    auto supports_fast_advance() const -> bool override { return true; }
+
+    auto advance_solution(solution_t &solution, const mode_t &mode, unsigned steps) const -> unsigned override
+    {
+        if (steps == 0) {
+            return 0;
+        }
+        const auto propagator = this->get_propagator(mode, steps);
+        const Scalar target   = this->target_state[progress_index];
+
+        // Find the first intermediate step that completes the solution, by
+        // looking only at the progress coordinate. The comparison matches the
+        // one of `is_complete`.
+        unsigned safe = steps;
+        for (unsigned step = 0; step < steps; ++step) {
+            const Scalar progress =
+                linear::dot(propagator->progress_rows[step], solution.state) + propagator->progress_offsets[step];
+            if (static_cast<double>(target - progress) < this->threshold) {
+                safe = step;
+                break;
+            }
+        }
+
+        // Near completion, fall back to the step-by-step simulation.
+        if (safe < steps) {
+            for (unsigned step = 0; step < safe; ++step) {
+                this->updated_solution(solution, mode);
+            }
+            return safe;
+        }
+
+        // Otherwise, apply the whole stride at once.
+        solution.resources.energy +=
+            linear::dot(propagator->energy_row, solution.state) + propagator->energy_offset;
+        solution.resources.time += static_cast<Scalar>(static_cast<double>(steps) * this->time_delta);
+        solution.state    = linear::add(linear::multiply(propagator->transition, solution.state), propagator->offset);
+        solution.distance = this->distance(solution);
+        return steps;
+    }
+
+    auto supports_stacked_advance() const -> bool override { return true; }
+
+    void advance_solution_stacked(
+        const solution_t &solution,
+        const std::vector<mode_t> &modes,
+        unsigned steps,
+        std::vector<solution_t> &children,
+        std::vector<unsigned> &advanced) const override
+    {
+        const std::size_t count = modes.size();
+        if ((steps == 0) || (count == 0)) {
+            children.insert(children.end(), count, solution);
+            advanced.insert(advanced.end(), count, 0U);
+            return;
+        }
+        const auto stacked  = this->get_stacked_propagator(modes, steps);
+        const Scalar target = this->target_state[progress_index];
+
+        // Scratch space for the progress, the states and the energies of all
+        // the modes, reused across calls.
+        thread_local std::vector<Scalar> scratch;
+        scratch.resize(count * (NS + 2));
+        Scalar *progress = scratch.data();
+        Scalar *states   = progress + count;
+        Scalar *energies = states + (NS * count);
+
+        // Find, for each mode, the first intermediate step that completes the
+        // solution, by looking only at the progress coordinate.
+        const std::size_t first = advanced.size();
+        advanced.resize(first + count, steps);
+        unsigned *safe        = advanced.data() + first;
+        std::size_t remaining = count;
+        for (unsigned step = 0; (step < steps) && (remaining > 0); ++step) {
+            linear::stacked_dot<Scalar, NS>(
+                stacked->progress_rows.data() + (step * NS * count), stacked->progress_offsets.data() + (step * count),
+                solution.state, count, progress);
+            for (std::size_t m = 0; m < count; ++m) {
+                if ((safe[m] == steps) && (static_cast<double>(target - progress[m]) < this->threshold)) {
+                    safe[m] = step;
+                    --remaining;
+                }
+            }
+        }
+
+        // Apply the whole stride under all the modes at once.
+        linear::stacked_affine<Scalar, NS, NS>(
+            stacked->transitions.data(), stacked->offsets.data(), solution.state, count, states);
+        linear::stacked_dot<Scalar, NS>(
+            stacked->energy_rows.data(), stacked->energy_offsets.data(), solution.state, count, energies);
+
+        // Build the children.
+        const auto stride = static_cast<Scalar>(static_cast<double>(steps) * this->time_delta);
+        for (std::size_t m = 0; m < count; ++m) {
+            children.push_back(solution);
+            auto &child = children.back();
+            if (safe[m] == steps) {
+                child.resources.energy += energies[m];
+                child.resources.time += stride;
+                for (std::size_t r = 0; r < NS; ++r) {
+                    child.state[r] = states[(r * count) + m];
+                }
+                child.distance = this->distance(child);
+            } else {
+                // Near completion, fall back to the step-by-step simulation.
+                for (unsigned step = 0; step < safe[m]; ++step) {
+                    this->updated_solution(child, modes[m]);
+                }
+            }
+        }
+    }
+
+    auto crossing_solution(const solution_t &previous, const solution_t &current) const
+        -> std::optional<solution_t> override
+    {
+        const double d0 = this->distance(previous);
+        const double d1 = this->distance(current);
+        if ((d1 >= this->threshold) || (d0 <= d1)) {
+            return std::nullopt;
+        }
+        // The distance is linear in the state, hence, it is linear along the
+        // step as well, and the crossing of the threshold has a closed form.
+        double relative = std::clamp((d0 - this->threshold) / (d0 - d1), 0.0, 1.0);
+        // Nudge the crossing past the threshold, to absorb the rounding.
+        solution_t solution = current;
+        for (double nudge = 1e-12; nudge < 1e-03; nudge *= 10) {
+            solution.state     = this->interpolate_state(previous.state, current.state, relative);
+            solution.resources = this->interpolate_resources(previous.resources, current.resources, relative);
+            if (this->is_complete(solution)) {
+                solution.distance = this->distance(solution);
+                return solution;
+            }
+            relative = std::min(1.0, relative + nudge);
+        }
+        return std::nullopt;
+    }
+
+    auto append_settings(std::string &key) const -> bool override
+    {
+        return flexman::core::append_value(key, energy_weights) && flexman::core::append_value(key, progress_index);
+    }
+
+private:
+    /// @brief The cached effect of a number of consecutive steps of a mode.
+    struct propagator_t {
+        /// @brief The transition matrix of the whole stride, A^n.
+        Matrix<Scalar, NS, NS> transition{};
+        /// @brief The offset of the whole stride, g_n.
+        state_t offset{};
+        /// @brief The progress row of each step j, i.e., row p of A^j.
+        std::vector<state_t> progress_rows;
+        /// @brief The progress offset of each step j, i.e., g_j[p].
+        std::vector<Scalar> progress_offsets;
+        /// @brief The energy accumulated along the stride is energy_row * x + energy_offset.
+        state_t energy_row{};
+        /// @brief The energy accumulated along the stride from the input alone.
+        Scalar energy_offset{};
+    };
+
+    /// @brief The propagators of a set of modes, stacked with the mode index innermost.
+    struct stacked_propagator_t {
+        /// @brief The identifiers of the stacked modes, in order.
+        std::vector<flexman::core::ModeId> ids;
+        /// @brief The transition matrices, (r * NS + c) * count + m.
+        std::vector<Scalar> transitions;
+        /// @brief The offsets, r * count + m.
+        std::vector<Scalar> offsets;
+        /// @brief The progress rows of each step, (j * NS + c) * count + m.
+        std::vector<Scalar> progress_rows;
+        /// @brief The progress offsets of each step, j * count + m.
+        std::vector<Scalar> progress_offsets;
+        /// @brief The energy rows, c * count + m.
+        std::vector<Scalar> energy_rows;
+        /// @brief The energy offsets, m.
+        std::vector<Scalar> energy_offsets;
+
+        /// @brief Checks if the propagators belong to the given modes.
+        ///
+        /// @param modes The modes.
+        ///
+        /// @return True if the modes are the stacked ones, in the same order.
+        auto matches(const std::vector<mode_t> &modes) const -> bool
+        {
+            return std::equal(ids.begin(), ids.end(), modes.begin(), modes.end(), [](auto id, const auto &mode) {
+                return id == mode.id;
+            });
+        }
+    };
+
+    /// @brief Builds the propagator of a number of steps of a mode.
+    ///
+    /// @param mode The mode.
+    /// @param steps The number of steps.
+    ///
+    /// @return The propagator.
+    auto build_propagator(const mode_t &mode, unsigned steps) const -> propagator_t
+    {
+        using dstate_t = Vector<double, NS>;
+
+        if (progress_index >= NS) {
+            throw std::invalid_argument("progress_index is out of range");
+        }
+        // Accumulate in double precision, whatever the scalar type.
+        const auto A = linear::cast<double>(mode.system.A);
+        const auto u = linear::cast<double>(mode.input);
+        // The constant contribution of the input, and the energy weights of the state.
+        const dstate_t input_contribution = linear::multiply(linear::cast<double>(mode.system.B), u);
+        const dstate_t energy_rate        = linear::multiply(linear::cast<double>(energy_weights), u);
+
+        propagator_t propagator;
+        propagator.progress_rows.reserve(steps);
+        propagator.progress_offsets.reserve(steps);
+
+        Matrix<double, NS, NS> power = linear::identity<double, NS>();
+        Matrix<double, NS, NS> power_sum{};
+        dstate_t offset{};
+        dstate_t offset_sum{};
+        for (unsigned step = 0; step < steps; ++step) {
+            power      = linear::multiply(A, power);
+            offset     = linear::add(linear::multiply(A, offset), input_contribution);
+            power_sum  = linear::add(power_sum, power);
+            offset_sum = linear::add(offset_sum, offset);
+            propagator.progress_rows.push_back(linear::cast<Scalar>(power[progress_index]));
+            propagator.progress_offsets.push_back(static_cast<Scalar>(offset[progress_index]));
+        }
+        // The energy is the sum over the steps of the energy rate of the state,
+        // i.e., the rate applied to the sum of the powers and of the offsets.
+        const dstate_t rate_row  = linear::multiply(linear::transpose(power_sum), energy_rate);
+        propagator.transition    = linear::cast<Scalar>(power);
+        propagator.offset        = linear::cast<Scalar>(offset);
+        propagator.energy_row    = linear::cast<Scalar>(linear::scale(rate_row, this->time_delta));
+        propagator.energy_offset = static_cast<Scalar>(linear::dot(energy_rate, offset_sum) * this->time_delta);
+        return propagator;
+    }
+
+    /// @brief Returns the cached propagator of a number of steps of a mode,
+    /// building it on first use.
+    ///
+    /// @param mode The mode.
+    /// @param steps The number of steps.
+    ///
+    /// @return The propagator.
+    auto get_propagator(const mode_t &mode, unsigned steps) const -> std::shared_ptr<const propagator_t>
+    {
+        const auto key = std::make_pair(mode.id, steps);
+        {
+            std::shared_lock<std::shared_mutex> lock(propagators_mutex);
+            auto it = propagators.find(key);
+            if (it != propagators.end()) {
+                return it->second;
+            }
+        }
+        auto propagator = std::make_shared<const propagator_t>(this->build_propagator(mode, steps));
+        std::unique_lock<std::shared_mutex> lock(propagators_mutex);
+        return propagators.emplace(key, std::move(propagator)).first->second;
+    }
+
+    /// @brief Returns the cached stacked propagators of a number of steps of
+    /// a set of modes, building them on first use.
+    ///
+    /// @param modes The modes.
+    /// @param steps The number of steps.
+    ///
+    /// @return The stacked propagators.
+    auto get_stacked_propagator(const std::vector<mode_t> &modes, unsigned steps) const
+        -> std::shared_ptr<const stacked_propagator_t>
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(propagators_mutex);
+            auto it = stacked_propagators.find(steps);
+            if (it != stacked_propagators.end()) {
+                for (const auto &stacked : it->second) {
+                    if (stacked->matches(modes)) {
+                        return stacked;
+                    }
+                }
+            }
+        }
+        // Gather the propagators of the single modes, and interleave them.
+        const std::size_t count = modes.size();
+        auto stacked            = std::make_shared<stacked_propagator_t>();
+        stacked->ids.reserve(count);
+        stacked->transitions.resize(NS * NS * count);
+        stacked->offsets.resize(NS * count);
+        stacked->progress_rows.resize(steps * NS * count);
+        stacked->progress_offsets.resize(steps * count);
+        stacked->energy_rows.resize(NS * count);
+        stacked->energy_offsets.resize(count);
+        for (std::size_t m = 0; m < count; ++m) {
+            const auto propagator = this->get_propagator(modes[m], steps);
+            stacked->ids.emplace_back(modes[m].id);
+            for (std::size_t r = 0; r < NS; ++r) {
+                for (std::size_t c = 0; c < NS; ++c) {
+                    stacked->transitions[(((r * NS) + c) * count) + m] = propagator->transition[r][c];
+                }
+                stacked->offsets[(r * count) + m]     = propagator->offset[r];
+                stacked->energy_rows[(r * count) + m] = propagator->energy_row[r];
+            }
+            for (std::size_t step = 0; step < steps; ++step) {
+                for (std::size_t c = 0; c < NS; ++c) {
+                    stacked->progress_rows[(((step * NS) + c) * count) + m] = propagator->progress_rows[step][c];
+                }
+                stacked->progress_offsets[(step * count) + m] = propagator->progress_offsets[step];
+            }
+            stacked->energy_offsets[m] = propagator->energy_offset;
+        }
+        std::unique_lock<std::shared_mutex> lock(propagators_mutex);
+        stacked_propagators[steps].emplace_back(stacked);
+        return stacked;
+    }
+
+    /// @brief Protects the cached propagators.
+    mutable std::shared_mutex propagators_mutex;
+    /// @brief The cached propagators, by mode identifier and number of steps.
+    mutable std::map<std::pair<flexman::core::ModeId, unsigned>, std::shared_ptr<const propagator_t>> propagators;
+    /// @brief The cached stacked propagators, by number of steps.
+    mutable std::map<unsigned, std::vector<std::shared_ptr<const stacked_propagator_t>>> stacked_propagators;
+};
+
+} // namespace linear
+} // namespace flexman
@@ -0,0 +1,188 @@
+/// @file precision.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the conversions between precisions of the linear managers,
+/// and the verification of single-precision results.
+///
+/// @details
+/// Searching in single precision halves the memory taken by the partial
+/// solutions, but the rounding errors accumulate along the sequences. This file
+/// provides:
+/// - The `cast_modes` and `cast_manager` functions, which convert the modes and
+///   the manager of a problem to another scalar type.
+/// - The `verify_solutions` function, which re-simulates the solutions of a
+///   front with a reference manager (typically, in double precision), and flags
+///   the ones whose resources diverge beyond a tolerance.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/linear/common.hpp"
+#include "flexman/linear/kernels.hpp"
+#include "flexman/linear/manager.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/metrics.hpp"
+#include "flexman/search/seed.hpp"
+
+namespace flexman
+{
+namespace linear
+{
+
+/// @brief The outcome of the verification of a set of solutions.
+struct VerificationReport {
+    /// @brief The number of verified solutions.
+    std::size_t checked{};
+    /// @brief The indices of the solutions that diverge beyond the tolerance,
+    /// or that do not complete under the reference manager.
+    std::vector<std::size_t> diverging;
+    /// @brief The largest relative error on the energy.
+    double max_energy_error{};
+    /// @brief The largest relative error on the time.
+    double max_time_error{};
+
+    /// @brief Checks if all the solutions passed the verification.
+    ///
+    /// @return True if no solution diverges, false otherwise.
+    auto passed() const noexcept -> bool { return diverging.empty(); }
+};
+
+/// @brief Converts a set of modes to another scalar type.
+///
+/// @tparam To The target scalar type.
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam From The source scalar type.
+///
+/// @param modes The modes to convert.
+///
+/// @return The converted modes, with the same identifiers.
+template <typename To, std::size_t NS, std::size_t NI, typename From>
+auto cast_modes(const std::vector<Mode<NS, NI, From>> &modes) -> std::vector<Mode<NS, NI, To>>
+{
+    std::vector<Mode<NS, NI, To>> converted(modes.size());
+    for (std::size_t i = 0; i < modes.size(); ++i) {
+        converted[i].id       = modes[i].id;
+        converted[i].system.A = linear::cast<To>(modes[i].system.A);
+        converted[i].system.B = linear::cast<To>(modes[i].system.B);
+        converted[i].input    = linear::cast<To>(modes[i].input);
+    }
+    return converted;
+}
+
+/// @brief Converts a manager to another scalar type.
+///
+/// @tparam To The target scalar type.
+/// @tparam NS The number of states.
+/// @tparam NI The number of inputs.
+/// @tparam From The source scalar type.
+///
+/// @param manager The manager to convert.
+///
+/// @return The converted manager, with the same parameters.
+template <typename To, std::size_t NS, std::size_t NI, typename From>
+auto cast_manager(const LinearDiscreteManager<NS, NI, From> &manager) -> LinearDiscreteManager<NS, NI, To>
+{
+    LinearDiscreteManager<NS, NI, To> converted;
+    converted.initial_state  = linear::cast<To>(manager.initial_state);
+    converted.target_state   = linear::cast<To>(manager.target_state);
+    converted.time_delta     = manager.time_delta;
+    converted.time_max       = manager.time_max;
+    converted.threshold      = manager.threshold;
+    converted.timeout        = manager.timeout;
+    converted.interactive    = manager.interactive;
+    converted.energy_weights = linear::cast<To>(manager.energy_weights);
+    converted.progress_index = manager.progress_index;
+    return converted;
+}
+
+/// @brief Re-simulates a set of solutions with a reference manager, and checks
+/// that their resources agree within a relative tolerance.
+///
+/// @details Each sequence is re-simulated from the initial state of the
+/// reference manager, until it completes (see `search::adapt_solution`), hence,
+/// a solution whose completion moves by a step is still compared fairly.
+///
+/// @tparam State The type representing the state of the reference manager.
+/// @tparam Mode The type representing the mode of the reference manager.
+/// @tparam Resources The type representing the resources of the reference manager.
+/// @tparam OtherState The type representing the state of the verified solutions.
+/// @tparam OtherResources The type representing the resources of the verified solutions.
+///
+/// @param manager Pointer to the reference manager.
+/// @param modes The modes of the reference manager, indexed by their id.
+/// @param solutions The solutions to verify.
+/// @param tolerance The largest relative error allowed on energy and time.
+///
+/// @return The outcome of the verification.
+template <
+    typename State,
+    typename Mode,
+    flexman::search::EnergyTimeResources Resources,
+    typename OtherState,
+    flexman::search::EnergyTimeResources OtherResources>
+auto verify_solutions(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const std::vector<flexman::core::Solution<OtherState, OtherResources>> &solutions,
+    double tolerance) -> VerificationReport
+{
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    if (tolerance < 0) {
+        throw std::invalid_argument("tolerance must not be negative");
+    }
+
+    // The relative error, guarded against null references.
+    auto relative_error = [](double value, double reference) {
+        return std::abs(value - reference) / std::max(std::abs(reference), std::numeric_limits<double>::min());
+    };
+
+    VerificationReport report;
+    for (std::size_t i = 0; i < solutions.size(); ++i) {
+        const auto &solution = solutions[i];
+        ++report.checked;
+        auto reference = flexman::search::adapt_solution(manager, modes, solution.sequence);
+        if (!reference) {
+            qwarning(logging::search, "Solution %u does not complete under the reference manager.\n", i);
+            report.diverging.emplace_back(i);
+            continue;
+        }
+        const double energy_error = relative_error(
+            static_cast<double>(solution.resources.energy), static_cast<double>(reference->resources.energy));
+        const double time_error = relative_error(
+            static_cast<double>(solution.resources.time), static_cast<double>(reference->resources.time));
+        report.max_energy_error = std::max(report.max_energy_error, energy_error);
+        report.max_time_error   = std::max(report.max_time_error, time_error);
+        if ((energy_error > tolerance) || (time_error > tolerance)) {
+            qwarning(
+                logging::search, "Solution %u diverges from the reference (energy: %.3e, time: %.3e).\n", i,
+                energy_error, time_error);
+            report.diverging.emplace_back(i);
+        }
+    }
+
+    qinfo(
+        logging::search, "Verified %u solutions, %u diverge (max error, energy: %.3e, time: %.3e).\n", report.checked,
+        report.diverging.size(), report.max_energy_error, report.max_time_error);
+
+    return report;
+}
+
+} // namespace linear
+} // namespace flexman
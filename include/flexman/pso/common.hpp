@@ -14,6 +14,9 @@
 /// - The inertia weight, affecting velocity retention.
 /// - Cognitive and social coefficients, which balance exploration
 ///   and exploitation within the optimization process.
+/// - The number of sub-swarms of the island model, and how they migrate.
+/// - Whether the particles that do not complete are repaired.
+/// - Whether the simulation of a particle stops when it can not improve.
 ///
 /// These parameters are essential for tuning PSO-based optimization
 /// algorithms to achieve efficient convergence and exploration.
@@ -39,15 +42,39 @@ namespace pso
 /// @brief Structure to define PSO (Particle Swarm Optimization) parameters.
 struct SolverParameters {
     /// @brief Maximum number of iterations.
-    unsigned num_particles  = 100;
+    unsigned num_particles      = 100;
     /// @brief Maximum number of iterations.
-    unsigned max_iterations = 50;
+    unsigned max_iterations     = 50;
     /// @brief Weight for retaining previous velocity.
-    double inertia          = 0.2;
+    double inertia              = 0.2;
     /// @brief Weight for personal best influence.
-    double cognitive        = 0.4;
+    double cognitive            = 0.4;
     /// @brief Weight for global best influence.
-    double social           = 0.4;
+    double social               = 0.4;
+    /// @brief Number of sub-swarms sharing the particles, which evolve in
+    /// parallel between migrations (see `optimize_solution_islands`). One
+    /// runs a single swarm.
+    unsigned islands            = 1;
+    /// @brief Number of iterations between two migrations.
+    unsigned migration_interval = 5;
+    /// @brief Number of best particles each sub-swarm sends to the next one at
+    /// every migration.
+    unsigned migrants           = 1;
+    /// @brief Whether the particles that do not complete are repaired, by
+    /// extending their last mode, instead of being discarded.
+    bool repair                 = true;
+    /// @brief Whether the simulation of a particle stops as soon as it can not
+    /// improve the bests anymore. The energy and the time accumulated so far
+    /// are taken as a lower bound of the final fitness, which only holds if
+    /// the resources of the manager never decrease along a simulation, e.g.,
+    /// no mode recovers energy. The `Manager` does not check it, hence, enable
+    /// it only for such managers, otherwise the results change.
+    bool bounded                = false;
+    /// @brief Optional callback invoked at the end of each iteration, which can
+    /// pause the optimization, e.g., to let other jobs run (see
+    /// `JobScheduler`). Once it returns false, the optimization stops with the
+    /// best solution found so far, and it must keep returning false.
+    std::function<bool()> checkpoint;
 };
 
 } // namespace pso
@@ -12,6 +12,8 @@
 /// - Evaluation methods for determining the fitness of particles.
 /// - Optimization routines for refining solutions, Pareto fronts, and
 ///   full optimization results.
+/// - The island model, which splits the swarm in sub-swarms running in
+///   parallel, and exchanging their best particles periodically.
 ///
 /// The PSO implementation follows a swarm-based heuristic approach, iteratively
 /// improving solutions based on personal and global bests. It is particularly
@@ -25,12 +27,22 @@
 
 #pragma once
 
+#include "flexman/async_logging.hpp"
 #include "flexman/core/manager.hpp"
 #include "flexman/core/result.hpp"
+#include "flexman/executor.hpp"
 #include "flexman/pso/common.hpp"
 #include "flexman/simulation/simulate.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <random>
 
@@ -157,7 +169,15 @@ inline void update_all_particles(
 /// checks if the solution is valid (i.e., complete) and evaluates its fitness.
 /// If the particle improves upon the current personal or global bests, those
 /// bests are updated. The fitness is computed based on the energy and time
-/// resources used.
+/// resources used. When repairing, a particle that does not complete is moved
+/// to the sequence that extends its last mode until completion, in the same
+/// simulation, hence, it gets the fitness of a valid solution instead of the
+/// penalty.
+/// When bounded, the simulation stops as soon as the resources accumulated
+/// by the particle exceed both its personal best and the global best, since
+/// the particle can not improve them anymore; the particle then counts as not
+/// valid. This requires resources that never decrease along the simulation
+/// (see `SolverParameters::bounded`).
 ///
 /// @tparam State The type representing the system's state.
 /// @tparam Mode The type representing the system's mode.
@@ -165,7 +185,8 @@ inline void update_all_particles(
 ///
 /// @param manager Pointer to the manager handling the optimization process.
 /// @param modes A vector of modes available for the optimization process.
-/// @param particle The particle to evaluate (sequence of mode executions).
+/// @param particle The particle to evaluate (sequence of mode executions),
+/// repaired in place.
 /// @param personal_best The current personal best sequence of mode executions
 /// for the particle.
 /// @param personal_best_fitness The fitness value of the particle's personal
@@ -173,6 +194,8 @@ inline void update_all_particles(
 /// @param global_best The current global best sequence of mode executions
 /// across all particles.
 /// @param global_best_fitness The fitness value of the global best.
+/// @param repair Whether the particle is repaired if it does not complete.
+/// @param bounded Whether the simulation stops when it can not improve the bests.
 ///
 /// @return True if the solution generated by the particle is valid (complete);
 /// otherwise, false.
@@ -180,14 +203,31 @@ template <typename State, typename Mode, typename Resources>
 auto evaluate_particle(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const std::vector<Mode> &modes,
-    const std::vector<flexman::core::ModeExecution> &particle,
+    std::vector<flexman::core::ModeExecution> &particle,
     std::vector<flexman::core::ModeExecution> &personal_best,
     std::vector<flexman::core::ModeExecution> &global_best,
     double &personal_best_fitness,
-    double &global_best_fitness) -> bool
+    double &global_best_fitness,
+    bool repair  = true,
+    bool bounded = false) -> bool
 {
+    // When the resources never decrease, the fitness only grows along the
+    // simulation, hence, the accumulated one bounds the final one from below.
+    auto lower_bound = [](const flexman::core::Solution<State, Resources> &partial) {
+        return partial.resources.energy + partial.resources.time;
+    };
+    // The particle can only update the bests if it beats one of them.
+    const double cutoff =
+        bounded ? std::max(personal_best_fitness, global_best_fitness) : std::numeric_limits<double>::infinity();
+
     // Generate a solution from the current particle's sequence of mode executions.
-    auto solution = flexman::simulation::generate_solution(manager, modes, particle);
+    auto bounded_solution =
+        repair ? flexman::simulation::generate_repaired_solution(manager, modes, particle, cutoff, lower_bound)
+               : flexman::simulation::generate_bounded_solution(manager, modes, particle, cutoff, lower_bound);
+    if (!bounded_solution) {
+        return false;
+    }
+    const auto &solution = *bounded_solution;
 
     // Check if the generated solution meets the completion criteria.
     bool valid_solution = manager->is_complete(solution);
@@ -218,6 +258,264 @@ auto evaluate_particle(
     return valid_solution;
 }
 
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief A sub-swarm of the island model.
+struct Island {
+    /// @brief The particles, i.e., their sequences of mode executions.
+    std::vector<std::vector<flexman::core::ModeExecution>> particles;
+    /// @brief The personal best sequence of each particle.
+    std::vector<std::vector<flexman::core::ModeExecution>> personal_best;
+    /// @brief The velocities of each particle.
+    std::vector<std::vector<double>> velocities;
+    /// @brief The fitness of the personal best of each particle.
+    std::vector<double> personal_best_fitness;
+    /// @brief The best sequence found by the sub-swarm.
+    std::vector<flexman::core::ModeExecution> global_best;
+    /// @brief The fitness of the best sequence found by the sub-swarm.
+    double global_best_fitness = std::numeric_limits<double>::max();
+    /// @brief The random number generator of the sub-swarm.
+    std::mt19937 generator;
+    /// @brief The number of valid solutions in the last iteration.
+    std::size_t valid_solutions = 0;
+};
+
+/// @brief Initializes a sub-swarm around the initial solution, as `optimize_solution` does.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param initial_solution The initial solution to refine.
+/// @param num_particles The number of particles of the sub-swarm.
+///
+/// @return The sub-swarm.
+template <typename State, typename Resources>
+auto make_island(const flexman::core::Solution<State, Resources> &initial_solution, std::size_t num_particles)
+    -> Island
+{
+    auto [gen, dist] = initialize_random_generator(1.0, 10.0);
+    Island island{
+        .particles             = std::vector<std::vector<flexman::core::ModeExecution>>(num_particles),
+        .personal_best         = std::vector<std::vector<flexman::core::ModeExecution>>(num_particles),
+        .velocities            = std::vector<std::vector<double>>(num_particles),
+        .personal_best_fitness = std::vector<double>(num_particles, std::numeric_limits<double>::max()),
+        .global_best           = initial_solution.sequence,
+        .global_best_fitness   = initial_solution.resources.energy + initial_solution.resources.time,
+        .generator             = gen,
+        .valid_solutions       = 0,
+    };
+    for (std::size_t i = 0; i < num_particles; ++i) {
+        island.particles[i]     = initial_solution.sequence;
+        island.personal_best[i] = island.particles[i];
+        island.velocities[i].resize(island.particles[i].size(), 0.0);
+        // Add randomness while retaining structure.
+        for (auto &mode_exec : island.particles[i]) {
+            mode_exec.times = static_cast<std::size_t>(
+                std::max(static_cast<double>(mode_exec.times) + dist(island.generator) - 5.0, 1.0));
+        }
+    }
+    return island;
+}
+
+/// @brief Runs the given number of iterations of a sub-swarm.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Mode The type representing the system's mode.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param manager Pointer to the manager handling the optimization process.
+/// @param parameters The solver parameters.
+/// @param modes A vector of modes available for the optimization process.
+/// @param island The sub-swarm.
+/// @param iterations The number of iterations.
+template <typename State, typename Mode, typename Resources>
+void run_island(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const SolverParameters &parameters,
+    const std::vector<Mode> &modes,
+    Island &island,
+    std::size_t iterations)
+{
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        island.valid_solutions = 0;
+        for (std::size_t i = 0; i < island.particles.size(); ++i) {
+            island.valid_solutions += flexman::pso::evaluate_particle(
+                manager, modes, island.particles[i], island.personal_best[i], island.global_best,
+                island.personal_best_fitness[i], island.global_best_fitness, parameters.repair, parameters.bounded);
+        }
+        flexman::pso::update_all_particles(
+            parameters, island.personal_best, island.global_best, island.velocities, island.particles);
+    }
+}
+
+/// @brief Migrates the best particles of each sub-swarm to the next one, along a
+/// ring, where they replace the worst particles.
+///
+/// @param islands The sub-swarms.
+/// @param migrants The number of particles sent by each sub-swarm.
+inline void migrate(std::vector<Island> &islands, std::size_t migrants)
+{
+    // The ranking of the particles of an island, by the fitness of their personal best.
+    auto ranking = [](const Island &island) {
+        std::vector<std::size_t> order(island.particles.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&island](std::size_t a, std::size_t b) {
+            return island.personal_best_fitness[a] < island.personal_best_fitness[b];
+        });
+        return order;
+    };
+    // Collect the emigrants first, so that they do not travel further than one island.
+    std::vector<std::vector<std::pair<std::vector<flexman::core::ModeExecution>, double>>> emigrants(islands.size());
+    for (std::size_t i = 0; i < islands.size(); ++i) {
+        const auto order = ranking(islands[i]);
+        for (std::size_t k = 0; k < std::min(migrants, order.size()); ++k) {
+            emigrants[i].emplace_back(
+                islands[i].personal_best[order[k]], islands[i].personal_best_fitness[order[k]]);
+        }
+    }
+    for (std::size_t i = 0; i < islands.size(); ++i) {
+        auto &island     = islands[(i + 1) % islands.size()];
+        const auto order = ranking(island);
+        // The islands differ in size when the particles do not split evenly,
+        // hence, the receiver may have fewer particles than the migrants.
+        for (std::size_t k = 0; k < std::min(emigrants[i].size(), order.size()); ++k) {
+            const auto &[sequence, fitness] = emigrants[i][k];
+            const std::size_t worst         = order[order.size() - 1 - k];
+            // Only replace particles that are worse than the migrant.
+            if (!(fitness < island.personal_best_fitness[worst])) {
+                continue;
+            }
+            island.particles[worst]             = sequence;
+            island.personal_best[worst]         = sequence;
+            island.personal_best_fitness[worst] = fitness;
+            std::fill(island.velocities[worst].begin(), island.velocities[worst].end(), 0.0);
+            if (fitness < island.global_best_fitness) {
+                island.global_best         = sequence;
+                island.global_best_fitness = fitness;
+            }
+        }
+    }
+}
+
+/// @brief Returns the number of sub-swarms, each one keeps at least one particle.
+///
+/// @param parameters The solver parameters.
+///
+/// @return The number of sub-swarms.
+inline auto island_count(const SolverParameters &parameters) -> std::size_t
+{
+    return std::clamp<std::size_t>(parameters.islands, 1, std::max(parameters.num_particles, 1U));
+}
+
+} // namespace detail
+
+/// @brief Optimizes a solution with the island model of the Particle Swarm
+/// Optimization (PSO) algorithm.
+///
+/// @details The particles are split among independent sub-swarms, which run
+/// in parallel, each one on its own thread, and only synchronize every
+/// `migration_interval` iterations, when the best particles of each sub-swarm
+/// replace the worst ones of the next sub-swarm, along a ring. A slow
+/// evaluation thus only stalls its own sub-swarm, and the sub-swarms explore
+/// around different bests, which counters the premature convergence of a
+/// single swarm. The number of evaluations is the one of `optimize_solution`
+/// with the same parameters.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Mode The type representing the system's mode.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param manager Pointer to the manager handling the optimization process.
+/// @param parameters The solver parameters, including the number of sub-swarms
+/// and how they migrate.
+/// @param modes A vector of modes available for the optimization process.
+/// @param initial_solution The initial solution to refine and optimize.
+/// @param executor The executor running the sub-swarms, e.g., shared by the
+/// solutions of a front; when null, one thread per sub-swarm is started for
+/// this call only.
+///
+/// @return The optimized solution, with its mode execution sequence and resources.
+template <typename State, typename Mode, typename Resources>
+auto optimize_solution_islands(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const SolverParameters &parameters,
+    const std::vector<Mode> &modes,
+    const flexman::core::Solution<State, Resources> &initial_solution,
+    flexman::parallel::Executor *executor = nullptr) -> flexman::core::Solution<State, Resources>
+{
+    // Check if the parameters are valid.
+    if (parameters.num_particles == 0) {
+        throw std::invalid_argument("num_particles must be greater than 0");
+    }
+    if (parameters.migration_interval == 0) {
+        throw std::invalid_argument("migration_interval must be greater than 0");
+    }
+
+    // Split the particles among the sub-swarms, each one keeps at least one.
+    const std::size_t count = detail::island_count(parameters);
+    std::vector<detail::Island> islands;
+    islands.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t particles =
+            (parameters.num_particles / count) + ((i < (parameters.num_particles % count)) ? 1 : 0);
+        islands.emplace_back(detail::make_island(initial_solution, particles));
+    }
+
+    std::optional<flexman::parallel::Executor> owned;
+    if (executor == nullptr) {
+        executor = &owned.emplace(count);
+    }
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (std::size_t iteration = 0; iteration < parameters.max_iterations;) {
+        // Run the sub-swarms until the next migration.
+        const std::size_t epoch =
+            std::min<std::size_t>(parameters.migration_interval, parameters.max_iterations - iteration);
+        futures.clear();
+        for (auto &island : islands) {
+            futures.emplace_back(executor->submit([&, epoch]() {
+                detail::run_island(manager, parameters, modes, island, epoch);
+            }));
+        }
+        for (auto &future : futures) {
+            future.get();
+        }
+        iteration += epoch;
+        if (iteration < parameters.max_iterations) {
+            detail::migrate(islands, parameters.migrants);
+        }
+
+        // Print the progress of the PSO process.
+        const auto best = std::min_element(islands.begin(), islands.end(), [](const auto &a, const auto &b) {
+            return a.global_best_fitness < b.global_best_fitness;
+        });
+        std::size_t valid_solution_count = 0;
+        for (const auto &island : islands) {
+            valid_solution_count += island.valid_solutions;
+        }
+        qinfo_async(
+            logging::pso, "        Iteration %2u/%2u, best fitness: %6.2f, valid solutions: %3u/%3u, islands: %u\r",
+            iteration, parameters.max_iterations, best->global_best_fitness, valid_solution_count,
+            parameters.num_particles, count);
+
+        // Let the scheduler pause, or stop, the optimization.
+        if (parameters.checkpoint && !parameters.checkpoint()) {
+            break;
+        }
+    }
+
+    // Move to the next line in the output after progress updates.
+    qinfo_async(logging::pso, "\n");
+
+    // Generate and return the optimized solution based on the best particle of all the sub-swarms.
+    const auto best = std::min_element(islands.begin(), islands.end(), [](const auto &a, const auto &b) {
+        return a.global_best_fitness < b.global_best_fitness;
+    });
+    return flexman::simulation::generate_solution(manager, modes, best->global_best);
+}
+
 /// @brief Optimizes a solution using the Particle Swarm Optimization (PSO)
 /// algorithm.
 ///
@@ -237,6 +535,8 @@ auto evaluate_particle(
 /// inertia, cognitive/social weights, and the maximum number of iterations.
 /// @param modes A vector of modes available for the optimization process.
 /// @param initial_solution The initial solution to refine and optimize.
+/// @param executor The executor running the sub-swarms, if any (see
+/// `optimize_solution_islands`).
 ///
 /// @return The optimized solution, with its mode execution sequence and resources.
 template <typename State, typename Mode, typename Resources>
@@ -244,8 +544,14 @@ auto optimize_solution(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const SolverParameters &parameters,
     const std::vector<Mode> &modes,
-    const flexman::core::Solution<State, Resources> &initial_solution)
+    const flexman::core::Solution<State, Resources> &initial_solution,
+    flexman::parallel::Executor *executor = nullptr)
 {
+    // Split the swarm in islands, if requested.
+    if (parameters.islands > 1) {
+        return flexman::pso::optimize_solution_islands(manager, parameters, modes, initial_solution, executor);
+    }
+
     // Initialize containers for particles, personal bests, and velocities.
     std::vector<std::vector<flexman::core::ModeExecution>> particles(parameters.num_particles);
     std::vector<std::vector<flexman::core::ModeExecution>> personal_best(parameters.num_particles);
@@ -295,7 +601,9 @@ auto optimize_solution(
                 personal_best[i],         // Personal best sequence for this particle.
                 global_best,              // Global best sequence across all particles.
                 personal_best_fitness[i], // Fitness value of the particle's personal best.
-                global_best_fitness);     // Fitness value of the global best.
+                global_best_fitness,      // Fitness value of the global best.
+                parameters.repair,        // Whether the particles that do not complete are repaired.
+                parameters.bounded);      // Whether the simulations stop when they can not improve the bests.
         }
 
         // Update velocities and positions of all particles.
@@ -307,13 +615,18 @@ auto optimize_solution(
             particles);    // Current particles being updated.
 
         // Print the progress of the PSO process.
-        qinfo(
+        qinfo_async(
             logging::pso, "        Iteration %2u/%2u, best fitness: %6.2f, valid solutions: %3u/%3u\r", iteration + 1,
             parameters.max_iterations, global_best_fitness, valid_solution_count, parameters.num_particles);
+
+        // Let the scheduler pause, or stop, the optimization.
+        if (parameters.checkpoint && !parameters.checkpoint()) {
+            break;
+        }
     }
 
     // Move to the next line in the output after progress updates.
-    qinfo(logging::pso, "\n");
+    qinfo_async(logging::pso, "\n");
 
     // Generate and return the optimized solution based on the global best particle.
     return flexman::simulation::generate_solution(manager, modes, global_best);
@@ -330,6 +643,8 @@ auto optimize_solution(
 /// @param parameters The solver parameters to guide the optimization.
 /// @param modes A vector of modes available for the optimization process.
 /// @param pareto_front The Pareto front to refine and optimize.
+/// @param executor The executor running the sub-swarms, if any; when null and
+/// the swarm is split, one is started and shared by all the solutions.
 ///
 /// @return The optimized Pareto front.
 template <typename State, typename Mode, typename Resources>
@@ -337,21 +652,29 @@ auto optimize_pareto_front(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const SolverParameters &parameters,
     const std::vector<Mode> &modes,
-    const flexman::core::ParetoFront<State, Resources> &pareto_front)
+    const flexman::core::ParetoFront<State, Resources> &pareto_front,
+    flexman::parallel::Executor *executor = nullptr)
 {
+    std::optional<flexman::parallel::Executor> owned;
+    if ((executor == nullptr) && (parameters.islands > 1)) {
+        executor = &owned.emplace(detail::island_count(parameters));
+    }
+
     flexman::core::ParetoFront<State, Resources> optimized = {
         .solutions           = {},
         .step_length         = pareto_front.step_length,
         .steps_per_iteration = pareto_front.steps_per_iteration,
         .iteration           = pareto_front.iteration,
         .runtime             = pareto_front.runtime,
+        .hypervolume         = pareto_front.hypervolume,
     };
 
     std::size_t index = 1;
     std::size_t total = pareto_front.solutions.size();
+    optimized.solutions.reserve(total);
     for (const auto &solution : pareto_front.solutions) {
-        qinfo(logging::pso, "    Optimize solution %3u/%3u...\n", index++, total);
-        optimized.solutions.emplace_back(optimize_solution(manager, parameters, modes, solution));
+        qinfo_async(logging::pso, "    Optimize solution %3u/%3u...\n", index++, total);
+        optimized.solutions.emplace_back(optimize_solution(manager, parameters, modes, solution, executor));
     }
     return optimized;
 }
@@ -378,14 +701,23 @@ auto optimize_result(
 {
     flexman::core::Result<State, Resources> optimized = {
         .pareto_fronts = {},
+        .stop_reason   = result.stop_reason,
     };
 
+    // The sub-swarms of all the solutions share the same threads.
+    std::optional<flexman::parallel::Executor> executor;
+    if (parameters.islands > 1) {
+        executor.emplace(detail::island_count(parameters));
+    }
+
     std::size_t index = 1;
     std::size_t total = result.pareto_fronts.size();
+    optimized.pareto_fronts.reserve(total);
     for (const auto &pareto_front : result.pareto_fronts) {
-        qinfo(
+        qinfo_async(
             logging::pso, "Optimize Pareto front (step: %6.2f) %3u/%3u...\n", pareto_front.step_length, index++, total);
-        optimized.pareto_fronts.emplace_back(optimize_pareto_front(manager, parameters, modes, pareto_front));
+        optimized.pareto_fronts.emplace_back(optimize_pareto_front(
+            manager, parameters, modes, pareto_front, executor ? &*executor : nullptr));
     }
     return optimized;
 }
@@ -0,0 +1,415 @@
+/// @file scheduler.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines a deadline-aware scheduler of concurrent jobs.
+///
+/// @details
+/// When many searches run in the same process, each one assumes it owns the
+/// machine, hence, they all slow down together and all their timeouts slip.
+/// This file provides the `JobScheduler` class, which admits jobs with a
+/// weight and a deadline, and lets only a fixed number of them run at once.
+/// The jobs are time-sliced cooperatively: each job receives a checkpoint,
+/// which it calls at the end of its iterations, e.g., through the `checkpoint`
+/// of the search and PSO parameters. At a checkpoint, once its quantum is
+/// over, a job yields its slot to the waiting job that comes first according
+/// to the policy:
+/// - `EarliestDeadlineFirst`, the job with the earliest deadline, and then
+///   with the highest weight.
+/// - `WeightedFair`, the job that ran the least, relative to its weight.
+///
+/// A job can also be stopped at its first checkpoint past the deadline, so
+/// that it returns the best results it found so far. The scheduler reports,
+/// for each job, the time it waited and ran, and whether it missed its
+/// deadline. Since the jobs that can not be admitted are rejected, an
+/// overloaded process degrades predictably: the admitted jobs keep their
+/// order, and the late ones are either stopped or reported.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flexman/executor.hpp"
+#include "flexman/logging.hpp"
+
+namespace flexman
+{
+namespace parallel
+{
+
+/// @brief The clock of the deadlines.
+using JobClock = std::chrono::steady_clock;
+
+/// @brief The checkpoint given to a job, which returns false once the job must stop.
+using Checkpoint = std::function<bool()>;
+
+/// @brief The order in which the waiting jobs receive a slot.
+enum class SchedulingPolicy : unsigned char {
+    EarliestDeadlineFirst, ///< The earliest deadline first, then the highest weight.
+    WeightedFair           ///< The least running time, relative to the weight, first.
+};
+
+/// @brief The options of a job.
+struct JobOptions {
+    /// @brief The name of the job, used in the reports.
+    std::string name;
+    /// @brief The time by which the job should complete, none by default.
+    JobClock::time_point deadline = JobClock::time_point::max();
+    /// @brief The weight of the job, i.e., its share of the slots under the
+    /// weighted fair policy, and its priority among equal deadlines.
+    double weight                 = 1.0;
+    /// @brief Whether the checkpoint stops the job once its deadline passed.
+    bool stop_at_deadline         = false;
+};
+
+/// @brief The report of a completed job.
+struct JobReport {
+    /// @brief The identifier of the job, in order of submission.
+    std::size_t id{};
+    /// @brief The name of the job.
+    std::string name;
+    /// @brief The time spent waiting for a slot, in seconds.
+    double waiting{};
+    /// @brief The time spent running, in seconds.
+    double running{};
+    /// @brief The time between the deadline and the completion, in seconds,
+    /// negative when the job completed in time, zero without a deadline.
+    double lateness{};
+    /// @brief Whether the job completed after its deadline.
+    bool missed{};
+    /// @brief Whether the checkpoint stopped the job.
+    bool stopped{};
+};
+
+/// @brief Runs jobs on its own threads, time-slicing them cooperatively.
+///
+/// @details A job waiting for a slot blocks its thread inside a checkpoint,
+/// hence, each admitted job needs a thread of its own. The scheduler starts
+/// `capacity` threads when it is constructed, and only `slots` of them run at
+/// once, while the others sleep until they receive a slot or a job.
+class JobScheduler
+{
+public:
+    /// @brief Constructs the scheduler, and starts one thread per job it can admit.
+    ///
+    /// @param _slots The number of jobs running at once, zero uses one per hardware thread.
+    /// @param _policy The order in which the waiting jobs receive a slot.
+    /// @param _quantum The time a job runs before yielding its slot at a checkpoint.
+    /// @param _capacity The number of jobs admitted at once, running or waiting.
+    explicit JobScheduler(
+        std::size_t _slots                 = 0,
+        SchedulingPolicy _policy           = SchedulingPolicy::EarliestDeadlineFirst,
+        std::chrono::microseconds _quantum = std::chrono::milliseconds(10),
+        std::size_t _capacity              = 64)
+        : slots(_slots ? _slots : std::max(1U, std::thread::hardware_concurrency()))
+        , policy(_policy)
+        , quantum(_quantum)
+        , capacity(_capacity)
+        , executor(_capacity)
+    {
+        if (capacity < slots) {
+            throw std::invalid_argument("the capacity must not be lower than the number of slots");
+        }
+    }
+
+    /// @brief Copy constructor (deleted, the scheduler owns its jobs).
+    JobScheduler(const JobScheduler &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, the scheduler owns its jobs).
+    auto operator=(const JobScheduler &other) -> JobScheduler & = delete;
+
+    /// @brief Admits a job.
+    ///
+    /// @param options The options of the job.
+    /// @param function The job, a callable taking the `Checkpoint` it must call
+    /// at the end of its iterations.
+    ///
+    /// @return The future holding the result of the job.
+    template <typename Function>
+    auto submit(JobOptions options, Function &&function)
+        -> std::future<std::invoke_result_t<std::decay_t<Function>, const Checkpoint &>>
+    {
+        if (!(options.weight > 0.0)) {
+            throw std::invalid_argument("the weight of a job must be greater than 0");
+        }
+        auto job = std::make_shared<job_t>();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (jobs.size() >= capacity) {
+                throw std::runtime_error("the scheduler can not admit more jobs");
+            }
+            job->id      = next_id++;
+            job->options = std::move(options);
+            // A new job starts from the least virtual time, so that it does
+            // not take over the jobs that already ran.
+            if (!jobs.empty()) {
+                job->virtual_time = jobs.front()->virtual_time;
+                for (const auto &other : jobs) {
+                    job->virtual_time = std::min(job->virtual_time, other->virtual_time);
+                }
+            }
+            job->state        = state_t::Waiting;
+            job->waiting_from = JobClock::now();
+            jobs.emplace_back(job);
+        }
+        return executor.submit([this, job, function = std::forward<Function>(function)]() mutable {
+            const Checkpoint checkpoint = [this, job]() { return this->checkpoint(*job); };
+            this->acquire(*job);
+            try {
+                if constexpr (std::is_void_v<std::invoke_result_t<std::decay_t<Function>, const Checkpoint &>>) {
+                    function(checkpoint);
+                    this->finish(*job);
+                } else {
+                    auto result = function(checkpoint);
+                    this->finish(*job);
+                    return result;
+                }
+            } catch (...) {
+                this->finish(*job);
+                throw;
+            }
+        });
+    }
+
+    /// @brief Returns the reports of the completed jobs, in order of completion.
+    ///
+    /// @return The reports.
+    auto reports() const -> std::vector<JobReport>
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completed;
+    }
+
+    /// @brief Returns the number of completed jobs that missed their deadline.
+    ///
+    /// @return The number of deadline misses.
+    auto deadline_misses() const -> std::size_t
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<std::size_t>(
+            std::count_if(completed.begin(), completed.end(), [](const auto &report) { return report.missed; }));
+    }
+
+    /// @brief Returns the number of jobs running at once.
+    ///
+    /// @return The number of slots.
+    auto size() const noexcept -> std::size_t { return slots; }
+
+private:
+    /// @brief The state of a job.
+    enum class state_t : unsigned char {
+        Waiting, ///< Waiting for a slot.
+        Running, ///< Holding a slot.
+        Released ///< Stopped or completed, without a slot.
+    };
+
+    /// @brief The bookkeeping of a job.
+    struct job_t {
+        /// @brief The identifier of the job.
+        std::size_t id{};
+        /// @brief The options of the job.
+        JobOptions options;
+        /// @brief The state of the job.
+        state_t state = state_t::Waiting;
+        /// @brief When the job started waiting for a slot.
+        JobClock::time_point waiting_from;
+        /// @brief When the job received its slot.
+        JobClock::time_point granted;
+        /// @brief When the running time was last accounted.
+        JobClock::time_point accounted;
+        /// @brief The time spent waiting.
+        JobClock::duration waiting{};
+        /// @brief The time spent running.
+        JobClock::duration running{};
+        /// @brief The running time divided by the weight, in seconds.
+        double virtual_time{};
+        /// @brief Whether the checkpoint stopped the job.
+        bool stopped{};
+    };
+
+    /// @brief Checks if a job comes before another according to the policy.
+    ///
+    /// @param lhs The first job.
+    /// @param rhs The second job.
+    ///
+    /// @return True if the first job comes first, false otherwise.
+    auto precedes(const job_t &lhs, const job_t &rhs) const -> bool
+    {
+        if (policy == SchedulingPolicy::EarliestDeadlineFirst) {
+            if (lhs.options.deadline != rhs.options.deadline) {
+                return lhs.options.deadline < rhs.options.deadline;
+            }
+            if ((lhs.options.weight > rhs.options.weight) || (lhs.options.weight < rhs.options.weight)) {
+                return lhs.options.weight > rhs.options.weight;
+            }
+        } else if ((lhs.virtual_time < rhs.virtual_time) || (lhs.virtual_time > rhs.virtual_time)) {
+            return lhs.virtual_time < rhs.virtual_time;
+        }
+        return lhs.id < rhs.id;
+    }
+
+    /// @brief Checks if a waiting job precedes the given one.
+    ///
+    /// @param job The job.
+    ///
+    /// @return True if another job should run first, false otherwise.
+    auto is_preceded(const job_t &job) const -> bool
+    {
+        return std::any_of(jobs.begin(), jobs.end(), [&](const auto &other) {
+            return (other.get() != &job) && (other->state == state_t::Waiting) && this->precedes(*other, job);
+        });
+    }
+
+    /// @brief Waits until the waiting job receives a slot, the lock must be held.
+    ///
+    /// @param lock The lock on the mutex.
+    /// @param job The job.
+    void wait_for_slot(std::unique_lock<std::mutex> &lock, job_t &job)
+    {
+        turn.wait(lock, [&]() { return (running_jobs < slots) && !this->is_preceded(job); });
+        const auto now = JobClock::now();
+        job.waiting  += now - job.waiting_from;
+        job.state     = state_t::Running;
+        job.granted   = now;
+        job.accounted = now;
+        ++running_jobs;
+    }
+
+    /// @brief Accounts the running time of a job and releases its slot, the
+    /// lock must be held.
+    ///
+    /// @param job The job.
+    /// @param next The state of the job after the release.
+    void release(job_t &job, state_t next)
+    {
+        if (job.state == state_t::Running) {
+            this->account(job);
+            --running_jobs;
+        }
+        job.state = next;
+        if (next == state_t::Waiting) {
+            job.waiting_from = JobClock::now();
+        }
+        turn.notify_all();
+    }
+
+    /// @brief Accounts the running time of a job since the last time.
+    ///
+    /// @param job The job.
+    void account(job_t &job)
+    {
+        const auto now = JobClock::now();
+        job.running      += now - job.accounted;
+        job.virtual_time += std::chrono::duration<double>(now - job.accounted).count() / job.options.weight;
+        job.accounted     = now;
+    }
+
+    /// @brief Waits until the job receives its first slot.
+    ///
+    /// @param job The job.
+    void acquire(job_t &job)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        this->wait_for_slot(lock, job);
+    }
+
+    /// @brief The checkpoint of a job: stops it past its deadline, if
+    /// requested, and yields its slot once its quantum is over.
+    ///
+    /// @param job The job.
+    ///
+    /// @return False if the job must stop, true otherwise.
+    auto checkpoint(job_t &job) -> bool
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (job.stopped) {
+            return false;
+        }
+        const auto now = JobClock::now();
+        if (job.options.stop_at_deadline && (now > job.options.deadline)) {
+            job.stopped = true;
+            this->release(job, state_t::Released);
+            return false;
+        }
+        this->account(job);
+        if (((now - job.granted) >= quantum) && this->is_preceded(job)) {
+            this->release(job, state_t::Waiting);
+            this->wait_for_slot(lock, job);
+        }
+        return true;
+    }
+
+    /// @brief Releases the slot of a completed job, and reports it.
+    ///
+    /// @param job The job.
+    void finish(job_t &job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->release(job, state_t::Released);
+        const auto now = JobClock::now();
+        JobReport report{
+            .id       = job.id,
+            .name     = job.options.name,
+            .waiting  = std::chrono::duration<double>(job.waiting).count(),
+            .running  = std::chrono::duration<double>(job.running).count(),
+            .lateness = 0.0,
+            .missed   = false,
+            .stopped  = job.stopped,
+        };
+        if (job.options.deadline != JobClock::time_point::max()) {
+            report.lateness = std::chrono::duration<double>(now - job.options.deadline).count();
+            report.missed   = report.lateness > 0.0;
+        }
+        if (report.missed) {
+            qwarning(
+                logging::common, "Job %u (%s) missed its deadline by %.3f s (waited %.3f s, ran %.3f s)%s.\n",
+                report.id, report.name.c_str(), report.lateness, report.waiting, report.running,
+                report.stopped ? ", and was stopped" : "");
+        }
+        completed.emplace_back(std::move(report));
+        std::erase_if(jobs, [&](const auto &other) { return other.get() == &job; });
+    }
+
+    /// @brief The number of jobs running at once.
+    std::size_t slots;
+    /// @brief The order in which the waiting jobs receive a slot.
+    SchedulingPolicy policy;
+    /// @brief The time a job runs before yielding its slot at a checkpoint.
+    std::chrono::microseconds quantum;
+    /// @brief The number of jobs admitted at once.
+    std::size_t capacity;
+    /// @brief Protects the jobs and the reports.
+    mutable std::mutex mutex;
+    /// @brief Signals the waiting jobs that a slot may be available.
+    std::condition_variable turn;
+    /// @brief The admitted jobs, running or waiting.
+    std::vector<std::shared_ptr<job_t>> jobs;
+    /// @brief The number of jobs holding a slot.
+    std::size_t running_jobs{};
+    /// @brief The identifier of the next job.
+    std::size_t next_id{};
+    /// @brief The reports of the completed jobs.
+    std::vector<JobReport> completed;
+    /// @brief The threads of the jobs, one per admitted job, destroyed first.
+    Executor executor;
+};
+
+} // namespace parallel
+} // namespace flexman
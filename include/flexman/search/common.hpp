@@ -26,9 +26,13 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -40,10 +44,13 @@
 
 #include <timelib/timer.hpp>
 
+#include "flexman/async_logging.hpp"
 #include "flexman/core/manager.hpp"
 #include "flexman/core/mode.hpp"
 #include "flexman/core/solution.hpp"
 #include "flexman/logging.hpp"
+#include "flexman/search/cost_model.hpp"
+#include "flexman/search/counters.hpp"
 
 namespace flexman
 {
@@ -65,6 +72,70 @@ enum class SwitchingMode : unsigned char {
     Free        ///< Allows free switching between modes.
 };
 
+/// @brief Defines what the search does once the fronts stop improving.
+enum class ConvergenceAction : unsigned char {
+    Stop,        ///< Stops the search.
+    SkipToFinest ///< Skips the intermediate strides, and searches the finest one.
+};
+
+/// @brief The policies of the search engine (see `Search`).
+namespace policy
+{
+
+/// @brief The category of the policies setting the order of the extensions.
+struct extension_tag {};
+/// @brief The category of the policies filtering the partial solutions.
+struct filter_tag {};
+/// @brief The category of the policies removing the duplicate accepted solutions.
+struct deduplication_tag {};
+/// @brief The category of the policies resolving the overshoot of the completing step.
+struct overshoot_tag {};
+/// @brief The category of the policies truncating the partial solutions.
+struct truncation_tag {};
+/// @brief The category of the policies running the extensions.
+struct execution_tag {};
+
+} // namespace policy
+
+/// @brief Structure to define the search parameters.
+struct SearchParameters {
+    /// @brief Number of stride halvings, the first stride is 2^(iterations - 1) steps.
+    unsigned iterations              = 5;
+    /// @brief Memory budget (in bytes) for the partial solutions, above which
+    /// they are spilled to disk. Zero keeps all partial solutions in memory.
+    std::size_t partial_memory_limit = 0;
+    /// @brief Directory where spilled partial solutions are written. When
+    /// empty, the system temporary directory is used.
+    std::string spill_directory;
+    /// @brief Modes the search is allowed to start from. When empty, the
+    /// search starts from every available mode.
+    std::vector<flexman::core::ModeId> initial_modes;
+    /// @brief Relative hypervolume improvement between consecutive strides
+    /// below which the search is considered converged. Zero disables the
+    /// criterion, which requires resources with energy and time.
+    double convergence_tolerance         = 0.0;
+    /// @brief What to do once the search has converged.
+    ConvergenceAction convergence_action = ConvergenceAction::Stop;
+    /// @brief Optional model of the remaining cost, used to prune and order
+    /// the partial solutions. It requires states with indexable components,
+    /// and resources with energy and time.
+    std::shared_ptr<const CostModel> cost_model;
+    /// @brief Optional hardware counters, where the search accumulates the
+    /// measurements of its phases (see `log_counters`).
+    std::shared_ptr<SearchCounters> counters;
+    /// @brief Number of partial solutions completed before each iteration by
+    /// staying in their current mode, so that their complete solutions prune
+    /// the search from the start (see `rollout_partial_solutions`). Zero
+    /// disables the rollout.
+    std::size_t rollout_samples = 0;
+    /// @brief Optional callback invoked once at the end of each iteration, or
+    /// of each stride under the single-machine fast path, which can pause the
+    /// search, e.g., to let other searches run (see `JobScheduler`). Once it
+    /// returns false, the search stops with the solutions found so far, and it
+    /// must keep returning false.
+    std::function<bool()> checkpoint;
+};
+
 /// @brief Logs a set of solutions conditionally based on the specified log level.
 ///
 /// @tparam State The type representing the system's state.
@@ -120,6 +191,11 @@ auto find_solution_closest_to_zero(
     const flexman::core::Solution<State, Resources> &previous,
     const flexman::core::Solution<State, Resources> &current) -> flexman::core::Solution<State, Resources>
 {
+    // Use the analytic completion point, if the manager provides it.
+    if (auto crossing = manager->crossing_solution(previous, current)) {
+        return *crossing;
+    }
+
     // Get the initial distance to target from the previous solution.
     double distance = std::abs(previous.distance);
 
@@ -127,8 +203,9 @@ auto find_solution_closest_to_zero(
     double step_factor = std::max(1.0, distance / manager->threshold);
     double step_size   = manager->time_delta / (10 * step_factor);
 
-    // Variable to store the best complete solution found.
-    flexman::core::Solution<State, Resources> solution = previous;
+    // Variable to store the best complete solution found. It keeps the
+    // sequence of the current solution, which includes the last step.
+    flexman::core::Solution<State, Resources> solution = current;
 
     // Start iterating from low_time to high_time in small steps.
     for (double t = 0, relative = NAN; t <= manager->time_delta; t += step_size) {
@@ -142,17 +219,89 @@ auto find_solution_closest_to_zero(
 
         // Check if the interpolated solution is complete.
         if (manager->is_complete(solution)) {
+            solution.distance = manager->distance(solution);
             return solution;
         }
     }
 
-    // If no complete solution is found, return the best solution so far (which
-    // is the previous solution).
+    // If no interpolated solution is complete, return the current solution,
+    // which is complete and includes the last step.
     return current;
 }
 
+namespace policy
+{
+
+/// @brief Resolves the overshoot of the step that completes a solution, by
+/// interpolating the completion point (see `find_solution_closest_to_zero`).
+struct InterpolateOvershoot {
+    /// @brief The category of the policy.
+    using category = overshoot_tag;
+
+    /// @brief Resolves the overshoot.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param previous The solution before the completing step.
+    /// @param current The solution after the completing step.
+    ///
+    /// @return The completed solution.
+    template <typename State, typename Mode, class Resources>
+    static auto resolve(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const flexman::core::Solution<State, Resources> &previous,
+        const flexman::core::Solution<State, Resources> &current) -> flexman::core::Solution<State, Resources>
+    {
+        return flexman::search::find_solution_closest_to_zero(manager, previous, current);
+    }
+};
+
+} // namespace policy
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Completes a solution advanced by the manager: records the advanced
+/// steps in its sequence and, if the solution stopped right before completing,
+/// simulates the completing step and interpolates the completion point.
+///
+/// @tparam Overshoot The policy resolving the overshoot of the completing step.
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param search Pointer to the search manager handling the simulation.
+/// @param mode The mode used for advancing the solution.
+/// @param steps The number of steps requested.
+/// @param advanced The number of steps actually advanced.
+/// @param solution The advanced solution.
+template <typename Overshoot = policy::InterpolateOvershoot, typename State, typename Mode, class Resources>
+inline void finish_advanced_solution(
+    const flexman::core::Manager<State, Mode, Resources> *search,
+    const Mode &mode,
+    const unsigned steps,
+    const unsigned advanced,
+    flexman::core::Solution<State, Resources> &solution)
+{
+    flexman::core::detail::add_mode_execution_to_sequence(mode.id, solution.sequence, advanced);
+    if (advanced == steps) {
+        return;
+    }
+    auto previous = solution;
+    search->updated_solution(solution, mode);
+    flexman::core::detail::add_mode_execution_to_sequence(mode.id, solution.sequence);
+    solution = Overshoot::resolve(search, previous, solution);
+}
+
+} // namespace detail
+
 /// @brief Simulates the mode and produces a new solution.
 ///
+/// @tparam Overshoot The policy resolving the overshoot of the completing step.
 /// @tparam State The type representing the state.
 /// @tparam Mode The type representing the mode.
 /// @tparam Resources The type representing the resources.
@@ -163,7 +312,7 @@ auto find_solution_closest_to_zero(
 /// @param solution The initial solution to start the simulation from.
 ///
 /// @return The new solution obtained after the simulation.
-template <typename State, typename Mode, class Resources>
+template <typename Overshoot = policy::InterpolateOvershoot, typename State, typename Mode, class Resources>
 inline auto simulate_mode(
     const flexman::core::Manager<State, Mode, Resources> *search,
     const Mode &mode,
@@ -181,6 +330,14 @@ inline auto simulate_mode(
 
     flexman::core::Solution<State, Resources> previous;
 
+    // Let the manager advance the solution in one go, up to the step that
+    // completes it, which is then simulated and interpolated as usual.
+    if (search->supports_fast_advance()) {
+        const unsigned advanced = search->advance_solution(solution, mode, steps);
+        flexman::search::detail::finish_advanced_solution<Overshoot>(search, mode, steps, advanced, solution);
+        return solution;
+    }
+
     // Perform the simulation for the given number of steps, or until the
     // solution is complete.
     for (unsigned i = 0; i < steps; ++i) {
@@ -192,16 +349,78 @@ inline auto simulate_mode(
         flexman::core::detail::add_mode_execution_to_sequence(mode.id, solution.sequence);
         // If the solution is complete, interpolate to avoid overshoot.
         if (search->is_complete(solution)) {
-            return find_solution_closest_to_zero(search, previous, solution);
+            return Overshoot::resolve(search, previous, solution);
         }
     }
     // Return the updated solution.
     return solution;
 }
 
+namespace detail
+{
+
+/// @brief Extends the given set of partial solutions with every mode, letting
+/// the manager advance all of them together under each mode.
+///
+/// @tparam Overshoot The policy resolving the overshoot of the completing step.
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the search manager handling the extension process.
+/// @param modes The set of modes used to extend the solutions.
+/// @param steps_per_iteration The number of steps to simulate per iteration.
+/// @param partials The set of partial solutions to extend.
+/// @param global_timer The global timer to track the extension process duration.
+///
+/// @return The extended solutions, in the same order of the per-solution extension.
+template <typename Overshoot, typename State, typename Mode, class Resources>
+auto extend_solutions_batched(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const typename std::vector<Mode> &modes,
+    const unsigned steps_per_iteration,
+    const std::vector<flexman::core::Solution<State, Resources>> &partials,
+    const timelib::Timer &global_timer) -> std::vector<flexman::core::Solution<State, Resources>>
+{
+    // The children of all the partial solutions, one vector per mode.
+    std::vector<std::vector<flexman::core::Solution<State, Resources>>> children(modes.size());
+    std::vector<unsigned> advanced;
+    std::size_t extended_modes = 0;
+    for (; extended_modes < modes.size(); ++extended_modes) {
+        const auto &mode = modes[extended_modes];
+        auto &batch      = children[extended_modes];
+        batch            = partials;
+        advanced.clear();
+        manager->advance_solutions_batched(batch, mode, steps_per_iteration, advanced);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            flexman::search::detail::finish_advanced_solution<Overshoot>(
+                manager, mode, steps_per_iteration, advanced[i], batch[i]);
+        }
+        // Check if the timer has expired.
+        if (global_timer.has_timeout()) {
+            qwarning_async(logging::common, "Timer expired while extending solutions.\n");
+            ++extended_modes;
+            break;
+        }
+    }
+
+    // Interleave them, so that the children of each partial solution are contiguous.
+    std::vector<flexman::core::Solution<State, Resources>> solutions;
+    solutions.reserve(partials.size() * extended_modes);
+    for (std::size_t i = 0; i < partials.size(); ++i) {
+        for (std::size_t mode = 0; mode < extended_modes; ++mode) {
+            solutions.emplace_back(std::move(children[mode][i]));
+        }
+    }
+    return solutions;
+}
+
+} // namespace detail
+
 /// @brief Extends the given set of partial solutions using the set of modes.
 ///
 /// @tparam SwitchMode The switching mode for simulation.
+/// @tparam Overshoot The policy resolving the overshoot of the completing step.
 /// @tparam State The type representing the state.
 /// @tparam Mode The type representing the mode.
 /// @tparam Resources The type representing the resources.
@@ -213,7 +432,12 @@ inline auto simulate_mode(
 /// @param global_timer The global timer to track the extension process duration.
 ///
 /// @return A new set of extended solutions.
-template <SwitchingMode SwitchMode, typename State, typename Mode, class Resources>
+template <
+    SwitchingMode SwitchMode,
+    typename Overshoot = policy::InterpolateOvershoot,
+    typename State,
+    typename Mode,
+    class Resources>
 auto extend_solutions(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const typename std::vector<Mode> &modes,
@@ -239,40 +463,65 @@ auto extend_solutions(
     // Prepare a vector for the new solutions.
     std::vector<flexman::core::Solution<State, Resources>> solutions;
 
-    qdebug(logging::common, "[%8u] Before extending set of solutions.\n", partials.size());
+    // The steps advanced by each mode, when the manager advances them together.
+    const bool stacked = (SwitchMode == SwitchingMode::Free) && manager->supports_stacked_advance();
+    std::vector<unsigned> advanced;
+
+    qdebug_async(logging::common, "[%8u] Before extending set of solutions.\n", partials.size());
+
+    // Otherwise, the manager may advance all the partial solutions together under each mode.
+    if constexpr (SwitchMode == SwitchingMode::Free) {
+        if (!stacked && manager->supports_batched_advance()) {
+            solutions = flexman::search::detail::extend_solutions_batched<Overshoot>(
+                manager, modes, steps_per_iteration, partials, global_timer);
+            qdebug_async(logging::common, "[%8u] After extending set of solutions.\n", solutions.size());
+            return solutions;
+        }
+    }
 
     // Iterate over the partial solutions.
     for (const auto &partial : partials) {
         // We freely switch between all available machines.
         if constexpr (SwitchMode == SwitchingMode::Free) {
-            // Iterate over the modes.
-            for (const auto &mode : modes) {
-                // Simulate the given mode and store the new solution.
-                solutions.push_back(simulate_mode(manager, mode, steps_per_iteration, partial));
+            if (stacked) {
+                // Advance the partial under all the modes together.
+                const std::size_t first = solutions.size();
+                advanced.clear();
+                manager->advance_solution_stacked(partial, modes, steps_per_iteration, solutions, advanced);
+                for (std::size_t i = 0; i < modes.size(); ++i) {
+                    flexman::search::detail::finish_advanced_solution<Overshoot>(
+                        manager, modes[i], steps_per_iteration, advanced[i], solutions[first + i]);
+                }
+            } else {
+                // Iterate over the modes.
+                for (const auto &mode : modes) {
+                    // Simulate the given mode and store the new solution.
+                    solutions.push_back(simulate_mode<Overshoot>(manager, mode, steps_per_iteration, partial));
+                }
             }
         }
         // We switch to only subsequent machines.
         else if constexpr (SwitchMode == SwitchingMode::Increasing) {
             // Iterate over the modes.
-            for (flexman::core::ModeId mode = partial.sequence.back(); mode < modes.size(); ++mode) {
+            for (flexman::core::ModeId mode = partial.sequence.back().mode; mode < modes.size(); ++mode) {
                 // Simulate the given mode and store the new solution.
-                solutions.push_back(simulate_mode(manager, modes[mode], steps_per_iteration, partial));
+                solutions.push_back(simulate_mode<Overshoot>(manager, modes[mode], steps_per_iteration, partial));
             }
         }
         // Simple case without any switching.
         else {
             // Simulate the given mode and store the new solution.
             solutions.push_back(
-                simulate_mode(manager, modes[partial.sequence.back().mode], steps_per_iteration, partial));
+                simulate_mode<Overshoot>(manager, modes[partial.sequence.back().mode], steps_per_iteration, partial));
         }
         // Check if the timer has expired.
         if (global_timer.has_timeout()) {
-            qwarning(logging::common, "Timer expired while extending solutions.\n");
+            qwarning_async(logging::common, "Timer expired while extending solutions.\n");
             break;
         }
     }
 
-    qdebug(logging::common, "[%8u] After extending set of solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] After extending set of solutions.\n", solutions.size());
 
     // Return the new set of solutions.
     return solutions;
@@ -303,11 +552,11 @@ void remove_dominated_solutions(
         throw std::invalid_argument("solutions and solutions_to_check_against must not be the same.");
     }
 
-    qdebug(logging::common, "[%8u] Before removing dominated solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] Before removing dominated solutions.\n", solutions.size());
 
     // Check if solutions_to_check_against vecto is empty.
     if (solutions_to_check_against.empty()) {
-        qdebug(logging::common, "[%8u] After removing dominated solutions (SAME).\n", solutions.size());
+        qdebug_async(logging::common, "[%8u] After removing dominated solutions (SAME).\n", solutions.size());
         return;
     }
 
@@ -328,7 +577,7 @@ void remove_dominated_solutions(
             }),
         solutions.end());
 
-    qdebug(logging::common, "[%8u] After removing dominated solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] After removing dominated solutions.\n", solutions.size());
 }
 
 /// @brief Removes dominated solutions from a vector.
@@ -351,11 +600,11 @@ void remove_dominated_solutions(
         throw std::invalid_argument("manager pointer is null");
     }
 
-    qdebug(logging::common, "[%8u] Before removing dominated solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] Before removing dominated solutions.\n", solutions.size());
 
     // Check if solutions_to_check_against vecto is empty.
     if (solutions.empty()) {
-        qdebug(logging::common, "[%8u] After removing dominated solutions (SAME).\n", solutions.size());
+        qdebug_async(logging::common, "[%8u] After removing dominated solutions (SAME).\n", solutions.size());
         return;
     }
 
@@ -411,14 +660,14 @@ void remove_dominated_solutions(
 template <typename State, class Resources>
 void remove_duplicate_solutions(std::vector<flexman::core::Solution<State, Resources>> &solutions)
 {
-    qdebug(logging::common, "[%8u] Before removing duplicate solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] Before removing duplicate solutions.\n", solutions.size());
 
     // First, sort the solutions to bring duplicates together.
     std::sort(solutions.begin(), solutions.end());
     // Then, erase the duplicates from the vector.
     solutions.erase(std::unique(solutions.begin(), solutions.end()), solutions.end());
 
-    qdebug(logging::common, "[%8u] After removing duplicate solutions.\n", solutions.size());
+    qdebug_async(logging::common, "[%8u] After removing duplicate solutions.\n", solutions.size());
 }
 
 /// @brief Splits the given set of solutions into complete and partial
@@ -446,7 +695,8 @@ void split_complete_partial(
 
     // Check if solutions vector is not empty.
     if (!solutions.empty()) {
-        qdebug(logging::common, "[%8u] Before splitting among complete and partial solutions.\n", solutions.size());
+        qdebug_async(
+            logging::common, "[%8u] Before splitting among complete and partial solutions.\n", solutions.size());
 
         // Partition the solutions into complete and partial in-place.
         auto it = std::partition(solutions.begin(), solutions.end(), [&manager](const auto &solution) -> bool {
@@ -463,7 +713,7 @@ void split_complete_partial(
         solutions.clear();
 
         // We split between complete solutions and partial ones.
-        qdebug(
+        qdebug_async(
             logging::common, "[%8u] After among complete and partial solutions [complete: %8u, partial: %8u]\n",
             solutions.size(), complete.size(), partial.size());
     }
@@ -0,0 +1,288 @@
+/// @file coordinator.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Coalesces concurrent identical search requests.
+///
+/// @details
+/// Within a process, several threads may request the same search at nearly
+/// the same time, e.g., controllers reacting to the same event. This file
+/// provides the `SearchCoordinator` class, a front door to `perform_search`,
+/// which fingerprints each request and lets the duplicates of a request still
+/// in flight attach to it, and share its result, instead of repeating the
+/// search. The fingerprint covers:
+/// - The dynamic type of the manager, the fields of `Manager`, and the
+///   settings of the derived manager (see `Manager::append_settings`).
+/// - The identifiers, the systems, and the inputs of the modes.
+/// - The search algorithm and the search parameters.
+///
+/// The values are described by their content (see `fingerprint.hpp`), so that
+/// padding bytes and the sign of zero do not tell equal requests apart. Values
+/// that cannot be described, e.g., a manager that does not append its
+/// settings, are identified by their address instead, hence, two requests are
+/// never coalesced unless they are certainly identical. Only requests in
+/// flight are coalesced, a request issued after the previous one completed
+/// runs a new search.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "flexman/core/fingerprint.hpp"
+#include "flexman/core/manager.hpp"
+#include "flexman/core/result.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+#include "flexman/search/search.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+namespace detail
+{
+
+/// @brief Appends a value that can always be described to a fingerprint,
+/// e.g., a number or an enumeration (see `flexman::core::append_value`).
+///
+/// @tparam T The type of the value.
+///
+/// @param key the fingerprint.
+/// @param value the value.
+template <typename T>
+inline void append_bytes(std::string &key, const T &value)
+{
+    static_assert(
+        std::is_floating_point_v<T> || std::has_unique_object_representations_v<T>,
+        "only values without padding can be appended");
+    flexman::core::append_value(key, value);
+}
+
+/// @brief Appends an address to a fingerprint, for the values that can only
+/// be identified by their instance.
+///
+/// @param key the fingerprint.
+/// @param address the address.
+inline void append_address(std::string &key, const void *address)
+{
+    detail::append_bytes(key, address);
+}
+
+/// @brief Computes the fingerprint of a search request.
+///
+/// @tparam Algorithm The search algorithm.
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param parameters The search parameters.
+///
+/// @return The fingerprint, equal for two requests only if they produce the same search.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+inline auto fingerprint_request(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const SearchParameters &parameters) -> std::string
+{
+    std::string key;
+    detail::append_bytes(key, Algorithm);
+
+    // The manager.
+    key.append(typeid(*manager).name());
+    key.push_back('\0');
+    if (!flexman::core::append_value(key, manager->initial_state) ||
+        !flexman::core::append_value(key, manager->target_state)) {
+        detail::append_address(key, manager);
+    }
+    detail::append_bytes(key, manager->time_delta);
+    detail::append_bytes(key, manager->time_max);
+    detail::append_bytes(key, manager->threshold);
+    detail::append_bytes(key, manager->timeout.count());
+    detail::append_bytes(key, manager->interactive);
+    if (!manager->append_settings(key)) {
+        detail::append_address(key, manager);
+    }
+
+    // The modes.
+    detail::append_bytes(key, modes.size());
+    for (const auto &mode : modes) {
+        detail::append_bytes(key, mode.id);
+        if (!flexman::core::append_value(key, mode.system) || !flexman::core::append_value(key, mode.input)) {
+            detail::append_address(key, modes.data());
+            break;
+        }
+    }
+
+    // The parameters, the shared models are identified by their instance.
+    detail::append_bytes(key, parameters.iterations);
+    detail::append_bytes(key, parameters.partial_memory_limit);
+    detail::append_bytes(key, parameters.spill_directory.size());
+    key.append(parameters.spill_directory);
+    detail::append_bytes(key, parameters.initial_modes.size());
+    for (const auto id : parameters.initial_modes) {
+        detail::append_bytes(key, id);
+    }
+    detail::append_bytes(key, parameters.convergence_tolerance);
+    detail::append_bytes(key, parameters.convergence_action);
+    detail::append_address(key, parameters.cost_model.get());
+    detail::append_address(key, parameters.counters.get());
+    detail::append_bytes(key, parameters.rollout_samples);
+    // A checkpoint belongs to the request that set it, which can not share a search.
+    if (parameters.checkpoint) {
+        detail::append_address(key, &parameters);
+    }
+    return key;
+}
+
+} // namespace detail
+
+/// @brief Runs the searches requested by concurrent threads, coalescing the
+/// identical ones.
+///
+/// @details The first request of a kind runs the search on the calling
+/// thread, while the identical requests issued before it completes wait for
+/// it and receive a copy of its result. If the search throws, the exception
+/// is rethrown to all of them.
+///
+/// @tparam State The type representing the state.
+/// @tparam Resources The type representing the resources.
+template <typename State, typename Resources>
+class SearchCoordinator
+{
+public:
+    /// @brief The type of the results.
+    using result_t = flexman::core::Result<State, Resources>;
+
+    /// @brief Constructs the coordinator.
+    SearchCoordinator() = default;
+
+    /// @brief Copy constructor (deleted, the requests in flight are not shared).
+    SearchCoordinator(const SearchCoordinator &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, the requests in flight are not shared).
+    auto operator=(const SearchCoordinator &other) -> SearchCoordinator & = delete;
+
+    /// @brief Performs a search, or attaches to an identical one in flight.
+    ///
+    /// @tparam Algorithm The search algorithm.
+    /// @tparam Mode The type representing the mode.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The modes available for simulation.
+    /// @param parameters The search parameters.
+    ///
+    /// @return The result of the search containing the Pareto fronts.
+    template <SearchAlgorithm Algorithm, typename Mode>
+    auto search(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        const SearchParameters &parameters) -> result_t
+    {
+        if (!manager) {
+            throw std::invalid_argument("manager pointer is null");
+        }
+        const std::string key = detail::fingerprint_request<Algorithm>(manager, modes, parameters);
+
+        // Attach to the identical request in flight, or become it.
+        std::promise<result_t> promise;
+        std::shared_future<result_t> future;
+        bool attached = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = in_flight.find(key);
+            if (it != in_flight.end()) {
+                future   = it->second;
+                attached = true;
+                ++coalesced_requests;
+            } else {
+                future = promise.get_future().share();
+                in_flight.emplace(key, future);
+                ++computed_requests;
+            }
+        }
+        if (attached) {
+            qdebug(logging::search, "Attached to an identical search in flight.\n");
+            return future.get();
+        }
+
+        try {
+            promise.set_value(flexman::search::perform_search<Algorithm>(manager, modes, parameters));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight.erase(key);
+        }
+        return future.get();
+    }
+
+    /// @brief Performs a search using the given number of iterations, or
+    /// attaches to an identical one in flight.
+    ///
+    /// @tparam Algorithm The search algorithm.
+    /// @tparam Mode The type representing the mode.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The modes available for simulation.
+    /// @param iterations The number of iterations to perform in the search.
+    ///
+    /// @return The result of the search containing the Pareto fronts.
+    template <SearchAlgorithm Algorithm, typename Mode>
+    auto search(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        unsigned iterations = 5) -> result_t
+    {
+        SearchParameters parameters;
+        parameters.iterations = iterations;
+        return this->search<Algorithm>(manager, modes, parameters);
+    }
+
+    /// @brief Returns the number of requests that ran a search.
+    ///
+    /// @return The number of searches.
+    auto computed() const -> std::size_t
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return computed_requests;
+    }
+
+    /// @brief Returns the number of requests that attached to a search in flight.
+    ///
+    /// @return The number of coalesced requests.
+    auto coalesced() const -> std::size_t
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return coalesced_requests;
+    }
+
+private:
+    /// @brief Protects the requests in flight and the counters.
+    mutable std::mutex mutex;
+    /// @brief The requests in flight, by fingerprint.
+    std::unordered_map<std::string, std::shared_future<result_t>> in_flight;
+    /// @brief The number of requests that ran a search.
+    std::size_t computed_requests{};
+    /// @brief The number of requests that attached to a search in flight.
+    std::size_t coalesced_requests{};
+};
+
+} // namespace search
+} // namespace flexman
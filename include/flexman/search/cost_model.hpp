@@ -0,0 +1,393 @@
+/// @file cost_model.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements a learned model of the remaining cost of partial solutions.
+///
+/// @details
+/// This file provides a light regression model that estimates, from the state
+/// of a partial solution, the energy and time still needed to complete it. The
+/// model is trained offline from saved results, and the search uses it as an
+/// optional oracle to:
+/// - Prune the partial solutions whose optimistic completion, i.e., their
+///   resources plus the estimate reduced by a safety margin, is already
+///   dominated by an accepted solution.
+/// - Order the partial solutions, so that the most promising ones are
+///   extended first.
+///
+/// It includes:
+/// - The `CostFeatureState` concept and the `cost_features` function, which
+///   extracts the features of a solution (its state components and distance).
+/// - The `CostModel` structure, a ridge regression with standardized features.
+/// - The `CostSamples` structure and the `collect_cost_samples` function, which
+///   replay the solutions of a saved result to gather training samples.
+/// - The `fit_cost_model` function, which fits the model through the normal
+///   equations.
+/// - The `prune_with_cost_model` function, used by the search.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/result.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/search/metrics.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief States whose components can be used as features of the cost model.
+template <typename State>
+concept CostFeatureState = requires(const State &state, std::size_t index) {
+    { state.size() } -> std::convertible_to<std::size_t>;
+    { state[index] } -> std::convertible_to<double>;
+};
+
+/// @brief Extracts the features of a solution: its state components, followed
+/// by its distance from the target.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param manager Pointer to the manager, used to compute the distance.
+/// @param solution The solution.
+///
+/// @return The features of the solution.
+template <CostFeatureState State, typename Mode, typename Resources>
+auto cost_features(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const flexman::core::Solution<State, Resources> &solution) -> std::vector<double>
+{
+    std::vector<double> features;
+    features.reserve(solution.state.size() + 1);
+    for (std::size_t i = 0; i < solution.state.size(); ++i) {
+        features.emplace_back(static_cast<double>(solution.state[i]));
+    }
+    features.emplace_back(manager->distance(solution));
+    return features;
+}
+
+/// @brief A linear model of the remaining energy and time of a partial solution.
+struct CostModel {
+    /// @brief The mean of each feature, subtracted before the regression.
+    std::vector<double> mean;
+    /// @brief The scale of each feature, dividing it before the regression.
+    std::vector<double> scale;
+    /// @brief The weights of the remaining energy, the last one is the bias.
+    std::vector<double> energy_weights;
+    /// @brief The weights of the remaining time, the last one is the bias.
+    std::vector<double> time_weights;
+    /// @brief The relative safety margin subtracted from the estimates when pruning.
+    double margin = 0.1;
+
+    /// @brief Checks if the model has been trained.
+    /// @return true if the model has no weights, false otherwise.
+    auto empty() const noexcept -> bool { return energy_weights.empty() || time_weights.empty(); }
+
+    /// @brief Estimates the remaining energy and time.
+    ///
+    /// @param features the features of the partial solution.
+    ///
+    /// @return the estimated remaining energy and time, never negative.
+    auto predict(const std::vector<double> &features) const -> std::array<double, 2>
+    {
+        if (features.size() != mean.size()) {
+            throw std::invalid_argument("the number of features does not match the cost model");
+        }
+        double energy = energy_weights.back();
+        double time   = time_weights.back();
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            const double value = (features[i] - mean[i]) / scale[i];
+            energy += energy_weights[i] * value;
+            time += time_weights[i] * value;
+        }
+        return {std::max(energy, 0.0), std::max(time, 0.0)};
+    }
+};
+
+/// @brief The samples used to train a cost model.
+struct CostSamples {
+    /// @brief The features of each sample.
+    std::vector<std::vector<double>> features;
+    /// @brief The remaining energy and time of each sample.
+    std::vector<std::array<double, 2>> targets;
+};
+
+/// @brief Collects training samples by replaying the solutions of a saved result.
+///
+/// @details Each complete solution of the finest front is re-simulated, and
+/// every `stride` steps the partial solution is recorded together with the
+/// energy and time still needed to reach the end of the sequence. The search
+/// interpolates the step that completes a solution, hence, the end is the
+/// one of the saved solution, not the one of a full last step.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param manager Pointer to the manager the result was obtained with.
+/// @param modes The modes the result was obtained with, indexed by their id.
+/// @param result The saved result.
+/// @param samples The samples, where the new ones are appended.
+/// @param stride The number of steps between two samples.
+template <CostFeatureState State, typename Mode, EnergyTimeResources Resources>
+void collect_cost_samples(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const flexman::core::Result<State, Resources> &result,
+    CostSamples &samples,
+    std::size_t stride = 10)
+{
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    if (stride == 0) {
+        throw std::invalid_argument("stride must be greater than 0");
+    }
+    if (result.pareto_fronts.empty()) {
+        return;
+    }
+
+    for (const auto &solution : result.pareto_fronts.back().solutions) {
+        // Skip the solutions that use modes we do not know.
+        if (std::any_of(solution.sequence.begin(), solution.sequence.end(), [&](const auto &execution) {
+                return execution.mode >= modes.size();
+            })) {
+            continue;
+        }
+
+        flexman::core::Solution<State, Resources> partial{
+            .sequence  = {},
+            .state     = manager->initial_state,
+            .resources = Resources(),
+            .distance  = std::numeric_limits<double>::max(),
+        };
+
+        // Replay the sequence, recording the partial solutions before each
+        // step. The last step is not replayed, the saved solution holds its end.
+        std::size_t steps = 0;
+        for (const auto &execution : solution.sequence) {
+            steps += execution.times;
+        }
+        std::vector<std::pair<std::vector<double>, std::array<double, 2>>> recorded;
+        std::size_t step = 0;
+        for (const auto &execution : solution.sequence) {
+            for (std::size_t i = 0; i < execution.times; ++i, ++step) {
+                if ((step % stride) == 0) {
+                    recorded.emplace_back(
+                        flexman::search::cost_features(manager, partial),
+                        std::array<double, 2>{
+                            static_cast<double>(partial.resources.energy),
+                            static_cast<double>(partial.resources.time),
+                        });
+                }
+                if ((step + 1) < steps) {
+                    manager->updated_solution(partial, modes[execution.mode]);
+                }
+            }
+        }
+
+        // The targets are the resources still needed to reach the end, where
+        // the last step only covers its interpolated fraction.
+        for (auto &[features, consumed] : recorded) {
+            samples.features.emplace_back(std::move(features));
+            samples.targets.push_back({
+                std::max(static_cast<double>(solution.resources.energy) - consumed[0], 0.0),
+                std::max(static_cast<double>(solution.resources.time) - consumed[1], 0.0),
+            });
+        }
+    }
+}
+
+/// @brief Fits a cost model through ridge regression.
+///
+/// @param samples The training samples.
+/// @param regularization The ridge regularization factor.
+/// @param margin The relative safety margin of the model.
+///
+/// @return The fitted model.
+inline auto fit_cost_model(const CostSamples &samples, double regularization = 1e-3, double margin = 0.1)
+    -> CostModel
+{
+    if (samples.features.empty() || (samples.features.size() != samples.targets.size())) {
+        throw std::invalid_argument("the cost model needs a consistent, non-empty set of samples");
+    }
+
+    const std::size_t count = samples.features.size();
+    const std::size_t size  = samples.features.front().size();
+    // One more column for the bias.
+    const std::size_t width = size + 1;
+
+    CostModel model;
+    model.margin = margin;
+    model.mean.assign(size, 0.0);
+    model.scale.assign(size, 0.0);
+
+    // Compute the statistics of the features.
+    for (const auto &features : samples.features) {
+        if (features.size() != size) {
+            throw std::invalid_argument("all the samples must have the same number of features");
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            model.mean[i] += features[i] / static_cast<double>(count);
+        }
+    }
+    for (const auto &features : samples.features) {
+        for (std::size_t i = 0; i < size; ++i) {
+            const double deviation = features[i] - model.mean[i];
+            model.scale[i] += deviation * deviation / static_cast<double>(count);
+        }
+    }
+    for (auto &scale : model.scale) {
+        scale = (scale > 0.0) ? std::sqrt(scale) : 1.0;
+    }
+
+    // Accumulate the normal equations: (X^T X + lambda I) w = X^T y.
+    std::vector<double> gram(width * width, 0.0);
+    std::vector<double> energy_rhs(width, 0.0);
+    std::vector<double> time_rhs(width, 0.0);
+    std::vector<double> row(width, 1.0);
+    for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t i = 0; i < size; ++i) {
+            row[i] = (samples.features[s][i] - model.mean[i]) / model.scale[i];
+        }
+        for (std::size_t i = 0; i < width; ++i) {
+            for (std::size_t j = 0; j < width; ++j) {
+                gram[i * width + j] += row[i] * row[j];
+            }
+            energy_rhs[i] += row[i] * samples.targets[s][0];
+            time_rhs[i] += row[i] * samples.targets[s][1];
+        }
+    }
+    // The bias is not regularized.
+    for (std::size_t i = 0; i < size; ++i) {
+        gram[i * width + i] += regularization * static_cast<double>(count);
+    }
+
+    // Solve both systems through Gaussian elimination with partial pivoting.
+    for (std::size_t k = 0; k < width; ++k) {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i < width; ++i) {
+            if (std::abs(gram[i * width + k]) > std::abs(gram[pivot * width + k])) {
+                pivot = i;
+            }
+        }
+        if (std::abs(gram[pivot * width + k]) < 1e-12) {
+            throw std::runtime_error("the cost model normal equations are singular");
+        }
+        if (pivot != k) {
+            for (std::size_t j = 0; j < width; ++j) {
+                std::swap(gram[k * width + j], gram[pivot * width + j]);
+            }
+            std::swap(energy_rhs[k], energy_rhs[pivot]);
+            std::swap(time_rhs[k], time_rhs[pivot]);
+        }
+        for (std::size_t i = k + 1; i < width; ++i) {
+            const double factor = gram[i * width + k] / gram[k * width + k];
+            for (std::size_t j = k; j < width; ++j) {
+                gram[i * width + j] -= factor * gram[k * width + j];
+            }
+            energy_rhs[i] -= factor * energy_rhs[k];
+            time_rhs[i] -= factor * time_rhs[k];
+        }
+    }
+    model.energy_weights.assign(width, 0.0);
+    model.time_weights.assign(width, 0.0);
+    for (std::size_t k = width; k-- > 0;) {
+        double energy = energy_rhs[k];
+        double time   = time_rhs[k];
+        for (std::size_t j = k + 1; j < width; ++j) {
+            energy -= gram[k * width + j] * model.energy_weights[j];
+            time -= gram[k * width + j] * model.time_weights[j];
+        }
+        model.energy_weights[k] = energy / gram[k * width + k];
+        model.time_weights[k]   = time / gram[k * width + k];
+    }
+    return model;
+}
+
+/// @brief Prunes and orders partial solutions with a cost model.
+///
+/// @details A partial solution is pruned when an accepted solution uses
+/// strictly less energy and strictly less time than its optimistic completion,
+/// i.e., its resources plus the estimated remaining ones, reduced by the
+/// safety margin. The remaining partial solutions are sorted by increasing
+/// optimistic completion (energy plus time).
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param manager Pointer to the manager handling the search.
+/// @param model The cost model.
+/// @param partial_solutions The partial solutions to prune and order.
+/// @param accepted_solutions The accepted (complete) solutions.
+///
+/// @return The number of pruned partial solutions.
+template <CostFeatureState State, typename Mode, EnergyTimeResources Resources>
+auto prune_with_cost_model(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const CostModel &model,
+    std::vector<flexman::core::Solution<State, Resources>> &partial_solutions,
+    const std::vector<flexman::core::Solution<State, Resources>> &accepted_solutions) -> std::size_t
+{
+    // Compute the optimistic completion of each partial solution.
+    std::vector<std::pair<std::array<double, 2>, std::size_t>> optimistic;
+    optimistic.reserve(partial_solutions.size());
+    for (std::size_t i = 0; i < partial_solutions.size(); ++i) {
+        const auto &partial  = partial_solutions[i];
+        const auto remaining = model.predict(flexman::search::cost_features(manager, partial));
+        optimistic.emplace_back(
+            std::array<double, 2>{
+                static_cast<double>(partial.resources.energy) + (1.0 - model.margin) * remaining[0],
+                static_cast<double>(partial.resources.time) + (1.0 - model.margin) * remaining[1],
+            },
+            i);
+    }
+
+    // Drop the ones dominated by an accepted solution.
+    const std::size_t before = optimistic.size();
+    optimistic.erase(
+        std::remove_if(
+            optimistic.begin(), optimistic.end(),
+            [&](const auto &entry) {
+                return std::any_of(accepted_solutions.begin(), accepted_solutions.end(), [&](const auto &accepted) {
+                    return (static_cast<double>(accepted.resources.energy) < entry.first[0]) &&
+                           (static_cast<double>(accepted.resources.time) < entry.first[1]);
+                });
+            }),
+        optimistic.end());
+
+    // Order the survivors by their optimistic completion.
+    std::stable_sort(optimistic.begin(), optimistic.end(), [](const auto &lhs, const auto &rhs) {
+        return (lhs.first[0] + lhs.first[1]) < (rhs.first[0] + rhs.first[1]);
+    });
+    std::vector<flexman::core::Solution<State, Resources>> ordered;
+    ordered.reserve(optimistic.size());
+    for (const auto &entry : optimistic) {
+        ordered.emplace_back(std::move(partial_solutions[entry.second]));
+    }
+    partial_solutions.swap(ordered);
+
+    return before - partial_solutions.size();
+}
+
+} // namespace search
+} // namespace flexman
@@ -0,0 +1,518 @@
+/// @file counters.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the hardware performance counters of the search phases.
+///
+/// @details
+/// Wall-clock times alone do not tell whether a phase of the search is bound by
+/// computation or by cache misses. This file provides:
+/// - The `HardwareCounters` class, which opens a group of Linux `perf_event`
+///   counters (cycles, instructions, L1 data and last-level cache misses, and
+///   branch misses) for the calling thread, and closes it on destruction.
+/// - The `SearchCounters` class, which accumulates the counters and the
+///   wall-clock time of each phase of the search, together with the number of
+///   solutions the phase processed.
+/// - The `PhaseRecorder` class, used by the search to measure its phases.
+/// - The `log_counters` function, which reports the IPC and the misses per
+///   solution of each phase.
+///
+/// The counters degrade gracefully: the events the kernel refuses to open
+/// (e.g., on other platforms, inside containers, or with a restrictive
+/// `perf_event_paranoid`) are reported as unavailable, and the wall-clock times
+/// and solution counts are still recorded.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "flexman/logging.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief The hardware events recorded by the counters.
+enum class CounterEvent : unsigned char {
+    Cycles,       ///< CPU cycles.
+    Instructions, ///< Retired instructions.
+    L1DMisses,    ///< Level 1 data cache read misses.
+    LLCMisses,    ///< Last-level cache misses.
+    BranchMisses  ///< Mispredicted branches.
+};
+
+/// @brief The number of hardware events.
+inline constexpr std::size_t counter_event_count = 5;
+
+/// @brief The phases of a search iteration measured by the counters.
+enum class SearchPhase : unsigned char {
+    Extension, ///< Extension of the partial solutions with the modes.
+    Dominance, ///< Removal of the dominated and duplicate solutions.
+    Split,     ///< Split between complete and partial solutions.
+    Pruning    ///< Pruning of the partial solutions with the cost model.
+};
+
+/// @brief The number of search phases.
+inline constexpr std::size_t search_phase_count = 4;
+
+/// @brief A reading of the hardware events and of the wall-clock time.
+struct CounterSample {
+    /// @brief The value of each event, indexed by `CounterEvent`.
+    std::array<std::uint64_t, counter_event_count> events{};
+    /// @brief The wall-clock time, in seconds.
+    double seconds{};
+
+    /// @brief Returns the value of an event.
+    ///
+    /// @param event The event.
+    ///
+    /// @return The value of the event.
+    auto operator[](CounterEvent event) const noexcept -> std::uint64_t
+    {
+        return events[static_cast<std::size_t>(event)];
+    }
+
+    /// @brief Accumulates another sample.
+    ///
+    /// @param other The sample to add.
+    ///
+    /// @return A reference to this sample.
+    auto operator+=(const CounterSample &other) noexcept -> CounterSample &
+    {
+        for (std::size_t i = 0; i < counter_event_count; ++i) {
+            events[i] += other.events[i];
+        }
+        seconds += other.seconds;
+        return *this;
+    }
+
+    /// @brief Computes the difference between a later and an earlier sample.
+    ///
+    /// @param earlier The earlier sample.
+    ///
+    /// @return The events and the time elapsed in between.
+    auto operator-(const CounterSample &earlier) const noexcept -> CounterSample
+    {
+        CounterSample delta;
+        for (std::size_t i = 0; i < counter_event_count; ++i) {
+            // Scaled multiplexed values can slightly decrease between readings.
+            delta.events[i] = (events[i] > earlier.events[i]) ? (events[i] - earlier.events[i]) : 0;
+        }
+        delta.seconds = seconds - earlier.seconds;
+        return delta;
+    }
+};
+
+/// @brief A group of hardware counters, measuring the calling thread in user
+/// space. The counters run from construction to destruction.
+class HardwareCounters
+{
+public:
+    /// @brief Opens the counters, skipping the events that are not available.
+    HardwareCounters()
+    {
+        descriptors.fill(-1);
+#ifdef __linux__
+        for (std::size_t i = 0; i < counter_event_count; ++i) {
+            const int descriptor = HardwareCounters::open_event(static_cast<CounterEvent>(i), leader);
+            if (descriptor < 0) {
+                continue;
+            }
+            descriptors[i] = descriptor;
+            if (leader < 0) {
+                leader = descriptor;
+            }
+            order[members++] = i;
+        }
+#endif
+    }
+
+    /// @brief Closes the counters.
+    ~HardwareCounters()
+    {
+#ifdef __linux__
+        for (const int descriptor : descriptors) {
+            if (descriptor >= 0) {
+                ::close(descriptor);
+            }
+        }
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters &)                     = delete;
+    HardwareCounters(HardwareCounters &&)                          = delete;
+    auto operator=(const HardwareCounters &) -> HardwareCounters & = delete;
+    auto operator=(HardwareCounters &&) -> HardwareCounters &      = delete;
+
+    /// @brief Checks if at least one event is counted.
+    ///
+    /// @return True if some counters are available, false otherwise.
+    auto available() const noexcept -> bool { return leader >= 0; }
+
+    /// @brief Checks if an event is counted.
+    ///
+    /// @param event The event.
+    ///
+    /// @return True if the event is available, false otherwise.
+    auto supports(CounterEvent event) const noexcept -> bool
+    {
+        return descriptors[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    /// @brief Reads the current value of the counters, with a single system call
+    /// for the whole group. The unavailable events read as zero.
+    ///
+    /// @return The current sample.
+    auto read() const noexcept -> CounterSample
+    {
+        CounterSample sample;
+        sample.seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#ifdef __linux__
+        if (leader < 0) {
+            return sample;
+        }
+        // The group layout: number of members, time enabled, time running, and
+        // the values in the order the members were opened.
+        std::array<std::uint64_t, 3 + counter_event_count> buffer{};
+        const auto bytes = ::read(leader, buffer.data(), sizeof(buffer));
+        if ((bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) || (buffer[2] == 0)) {
+            return sample;
+        }
+        // When the group was multiplexed with other events, extrapolate the
+        // values to the whole time it was enabled.
+        const double scaling = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+        for (std::size_t i = 0; (i < members) && (i < buffer[0]); ++i) {
+            sample.events[order[i]] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + i]) * scaling);
+        }
+#endif
+        return sample;
+    }
+
+private:
+#ifdef __linux__
+    /// @brief Opens the counter of an event for the calling thread.
+    ///
+    /// @param event The event.
+    /// @param group The descriptor of the group leader, or -1 to open a leader.
+    ///
+    /// @return The descriptor of the counter, or -1 if it is not available.
+    static auto open_event(CounterEvent event, int group) noexcept -> int
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size           = sizeof(attributes);
+        attributes.type           = PERF_TYPE_HARDWARE;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+        attributes.read_format =
+            PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (event) {
+        case CounterEvent::Cycles:
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case CounterEvent::Instructions:
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case CounterEvent::L1DMisses:
+            attributes.type   = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+            break;
+        case CounterEvent::LLCMisses:
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case CounterEvent::BranchMisses:
+            attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        }
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0UL));
+    }
+#endif
+
+    /// @brief The descriptor of each event, -1 when it is not available.
+    std::array<int, counter_event_count> descriptors{};
+    /// @brief The events of the group, in the order they were opened.
+    std::array<std::size_t, counter_event_count> order{};
+    /// @brief The number of events in the group.
+    std::size_t members = 0;
+    /// @brief The descriptor of the group leader, -1 when no event is available.
+    int leader = -1;
+};
+
+/// @brief Returns the counters of the calling thread, opened on first use.
+///
+/// @return The counters of the calling thread.
+inline auto thread_counters() -> const HardwareCounters &
+{
+    thread_local const HardwareCounters counters;
+    return counters;
+}
+
+/// @brief The measurements accumulated for a phase of the search.
+struct PhaseCounters {
+    /// @brief The events and the wall-clock time spent in the phase.
+    CounterSample sample;
+    /// @brief The number of times the phase was executed.
+    std::size_t calls{};
+    /// @brief The number of solutions processed by the phase.
+    std::size_t solutions{};
+
+    /// @brief Computes the instructions per cycle.
+    ///
+    /// @return The instructions per cycle, or zero if no cycle was counted.
+    auto ipc() const noexcept -> double
+    {
+        const auto cycles = sample[CounterEvent::Cycles];
+        if (cycles == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(sample[CounterEvent::Instructions]) / static_cast<double>(cycles);
+    }
+
+    /// @brief Computes the occurrences of an event per processed solution.
+    ///
+    /// @param event The event.
+    ///
+    /// @return The occurrences per solution, or zero if no solution was processed.
+    auto per_solution(CounterEvent event) const noexcept -> double
+    {
+        return (solutions == 0) ? 0.0 : static_cast<double>(sample[event]) / static_cast<double>(solutions);
+    }
+};
+
+/// @brief Accumulates the hardware counters of each phase of a search.
+///
+/// @details The search records into it when it is set in the
+/// `SearchParameters`. Each thread measures itself with its own counters, and
+/// the measurements are accumulated under a lock, hence, the same object can
+/// be shared by concurrent searches. The workers of a sharded search run in
+/// separate processes, and keep their measurements to themselves.
+class SearchCounters
+{
+public:
+    /// @brief Accumulates a measurement of a phase.
+    ///
+    /// @param phase The phase.
+    /// @param delta The events and the time spent in the phase.
+    /// @param solutions The number of solutions processed by the phase.
+    /// @param hardware The counters that took the measurement.
+    void record(SearchPhase phase, const CounterSample &delta, std::size_t solutions, const HardwareCounters &hardware)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &counters = phases[static_cast<std::size_t>(phase)];
+        counters.sample += delta;
+        counters.calls += 1;
+        counters.solutions += solutions;
+        for (std::size_t i = 0; i < counter_event_count; ++i) {
+            supported[i] = supported[i] || hardware.supports(static_cast<CounterEvent>(i));
+        }
+    }
+
+    /// @brief Returns the measurements of a phase.
+    ///
+    /// @param phase The phase.
+    ///
+    /// @return The measurements accumulated so far.
+    auto phase(SearchPhase phase) const -> PhaseCounters
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return phases[static_cast<std::size_t>(phase)];
+    }
+
+    /// @brief Returns the measurements of all the phases together.
+    ///
+    /// @details The solutions are the ones extended by the search, so that the
+    /// misses per solution of the total are comparable with the phases. When
+    /// the extension runs on several threads, its time is the sum of the time
+    /// of each thread.
+    ///
+    /// @return The measurements accumulated so far.
+    auto total() const -> PhaseCounters
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PhaseCounters total;
+        for (const auto &counters : phases) {
+            total.sample += counters.sample;
+        }
+        total.calls     = phases[static_cast<std::size_t>(SearchPhase::Extension)].calls;
+        total.solutions = phases[static_cast<std::size_t>(SearchPhase::Extension)].solutions;
+        return total;
+    }
+
+    /// @brief Checks if an event was counted by at least one measurement.
+    ///
+    /// @param event The event.
+    ///
+    /// @return True if the event is available, false otherwise.
+    auto supports(CounterEvent event) const -> bool
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return supported[static_cast<std::size_t>(event)];
+    }
+
+    /// @brief Discards the measurements, e.g., between two benchmarks.
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        phases    = {};
+        supported = {};
+    }
+
+private:
+    /// @brief Protects the measurements.
+    mutable std::mutex mutex;
+    /// @brief The measurements of each phase, indexed by `SearchPhase`.
+    std::array<PhaseCounters, search_phase_count> phases{};
+    /// @brief Which events were counted, indexed by `CounterEvent`.
+    std::array<bool, counter_event_count> supported{};
+};
+
+/// @brief Measures consecutive phases of the search on the calling thread.
+///
+/// @details The hardware counters only count the thread that reads them, hence,
+/// a recorder does not see the work that a phase hands to other threads. The
+/// phases that run on a pool, e.g., the extension under
+/// `policy::PooledExecution`, use a recorder on each worker, and each of them
+/// counts as a call of the phase. When constructed without a `SearchCounters`,
+/// it does nothing, so that the search pays a single branch per phase when
+/// profiling is disabled.
+class PhaseRecorder
+{
+public:
+    /// @brief Constructs the recorder.
+    ///
+    /// @param _counters Where the measurements are accumulated, or nullptr.
+    explicit PhaseRecorder(SearchCounters *_counters)
+        : counters(_counters)
+    {
+        // Nothing to do.
+    }
+
+    /// @brief Marks the beginning of a phase.
+    void start()
+    {
+        if (counters != nullptr) {
+            begin = thread_counters().read();
+        }
+    }
+
+    /// @brief Marks the end of a phase, and accumulates its measurement.
+    ///
+    /// @param phase The phase that ended.
+    /// @param solutions The number of solutions processed by the phase.
+    void stop(SearchPhase phase, std::size_t solutions)
+    {
+        if (counters != nullptr) {
+            const auto &hardware = thread_counters();
+            counters->record(phase, hardware.read() - begin, solutions, hardware);
+        }
+    }
+
+private:
+    /// @brief Where the measurements are accumulated.
+    SearchCounters *counters;
+    /// @brief The sample taken at the beginning of the current phase.
+    CounterSample begin;
+};
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Returns the name of a search phase.
+inline auto phase_name(SearchPhase phase) -> const char *
+{
+    switch (phase) {
+    case SearchPhase::Extension:
+        return "extension";
+    case SearchPhase::Dominance:
+        return "dominance";
+    case SearchPhase::Split:
+        return "split";
+    case SearchPhase::Pruning:
+        return "pruning";
+    }
+    return "unknown";
+}
+
+/// @brief Formats a rate, or a dash if the event was not counted.
+inline auto format_rate(const SearchCounters &counters, CounterEvent event, double value) -> std::string
+{
+    if (!counters.supports(event)) {
+        return "-";
+    }
+    std::array<char, 32> buffer{};
+    std::snprintf(buffer.data(), buffer.size(), "%.2f", value);
+    return buffer.data();
+}
+
+/// @brief Logs the measurements of a phase.
+inline void log_phase_counters(
+    quire::registry_t::value_t &logger,
+    const quire::log_level level,
+    const SearchCounters &counters,
+    const char *name,
+    const PhaseCounters &phase)
+{
+    qlog(
+        logger, level, "%-10s %8u %10u %9.3f %6s %9s %9s %9s\n", name, phase.calls, phase.solutions,
+        phase.sample.seconds,
+        (counters.supports(CounterEvent::Cycles) && counters.supports(CounterEvent::Instructions))
+            ? format_rate(counters, CounterEvent::Cycles, phase.ipc()).c_str()
+            : "-",
+        format_rate(counters, CounterEvent::L1DMisses, phase.per_solution(CounterEvent::L1DMisses)).c_str(),
+        format_rate(counters, CounterEvent::LLCMisses, phase.per_solution(CounterEvent::LLCMisses)).c_str(),
+        format_rate(counters, CounterEvent::BranchMisses, phase.per_solution(CounterEvent::BranchMisses)).c_str());
+}
+
+} // namespace detail
+
+/// @brief Logs the IPC and the misses per solution of each phase of a search,
+/// and of the whole search.
+///
+/// @param logger The logger instance used for logging.
+/// @param level The log level of the report.
+/// @param counters The measurements of the search.
+inline void log_counters(
+    quire::registry_t::value_t &logger,
+    const quire::log_level level,
+    const SearchCounters &counters)
+{
+    bool available = false;
+    for (std::size_t i = 0; i < counter_event_count; ++i) {
+        available = available || counters.supports(static_cast<CounterEvent>(i));
+    }
+    if (!available) {
+        qlog(logger, level, "Hardware counters are not available, reporting the wall-clock time only.\n");
+    }
+    qlog(
+        logger, level, "%-10s %8s %10s %9s %6s %9s %9s %9s\n", "Phase", "Calls", "Solutions", "Time (s)", "IPC",
+        "L1D/sol", "LLC/sol", "BrMis/sol");
+    for (std::size_t i = 0; i < search_phase_count; ++i) {
+        const auto phase = static_cast<SearchPhase>(i);
+        detail::log_phase_counters(logger, level, counters, detail::phase_name(phase), counters.phase(phase));
+    }
+    detail::log_phase_counters(logger, level, counters, "total", counters.total());
+}
+
+} // namespace search
+} // namespace flexman
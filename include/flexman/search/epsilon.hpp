@@ -0,0 +1,360 @@
+/// @file epsilon.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements an ε-constraint decomposition of the Pareto front.
+///
+/// @details
+/// Instead of finding the whole front through a single dominance-driven
+/// expansion, the ε-constraint method finds one point of the front at a time,
+/// as the solution of a single-objective search with a budget on the other
+/// objective. The searches are independent, hence, they run in parallel on an
+/// `Executor`. This file provides:
+/// - The `EpsilonParameters` structure, which configures the decomposition.
+/// - The `perform_constrained_search` function, which finds the solution with
+///   the lowest time (or energy) whose energy (or time) fits a budget.
+/// - The `energy_budgets` function, which spaces budgets uniformly.
+/// - The `perform_epsilon_constraint_search` function, which first finds the
+///   extreme points of the front, i.e., the minimum time and minimum energy
+///   solutions, and then a point for each budget of a uniform grid between
+///   them.
+///
+/// The resulting front is uniformly spaced in energy, and any region of it can
+/// be refined later, by searching explicit budgets within that region and
+/// merging the fronts.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/pareto_front.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/executor.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+#include "flexman/search/metrics.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief The objective minimized by a constrained search.
+enum class Objective : unsigned char {
+    Time,  ///< Minimizes the time, with a budget on the energy.
+    Energy ///< Minimizes the energy, with a budget on the time.
+};
+
+/// @brief Structure to define the parameters of the ε-constraint decomposition.
+struct EpsilonParameters {
+    /// @brief The number of budgets between the extreme points of the front.
+    unsigned points              = 8;
+    /// @brief The number of steps simulated per iteration of each constrained search.
+    unsigned steps_per_iteration = 8;
+    /// @brief The number of partial solutions each constrained search keeps
+    /// per iteration, the most promising ones. Zero keeps all of them.
+    std::size_t beam_width       = 256;
+    /// @brief Explicit energy budgets, e.g., to refine a region of a previous
+    /// front. When not empty, the extreme points and the uniform grid are
+    /// skipped, and only these budgets are searched.
+    std::vector<double> budgets;
+};
+
+/// @brief Spaces a number of energy budgets uniformly, strictly between two bounds.
+///
+/// @param lower The lower bound.
+/// @param upper The upper bound.
+/// @param points The number of budgets.
+///
+/// @return The budgets, in increasing order.
+inline auto energy_budgets(double lower, double upper, unsigned points) -> std::vector<double>
+{
+    std::vector<double> budgets;
+    budgets.reserve(points);
+    for (unsigned i = 1; i <= points; ++i) {
+        budgets.emplace_back(lower + ((upper - lower) * static_cast<double>(i) / static_cast<double>(points + 1)));
+    }
+    return budgets;
+}
+
+/// @brief Finds the complete solution minimizing an objective, among the ones
+/// whose other objective fits a budget.
+///
+/// @details The partial solutions are extended with every mode, one stride at
+/// a time. The ones exceeding the budget, or that cannot improve on the best
+/// complete solution found so far, are discarded, and the remaining ones are
+/// filtered with the heuristic dominance of the manager. Both prunings assume
+/// that energy and time never decrease along a solution. Finally, when a beam
+/// width is given, only the most promising partial solutions are kept: the
+/// closest to the target when minimizing time, and the ones that spent the
+/// least energy per unit of progress when minimizing energy.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param objective The objective to minimize.
+/// @param budget The budget on the other objective.
+/// @param steps_per_iteration The number of steps simulated per iteration.
+/// @param beam_width The number of partial solutions kept per iteration, zero keeps all of them.
+/// @param global_timer The timer tracking the duration of the search.
+///
+/// @return The best complete solution, or nothing if none fits the budget.
+template <typename State, typename Mode, EnergyTimeResources Resources>
+auto perform_constrained_search(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    Objective objective,
+    double budget,
+    unsigned steps_per_iteration,
+    std::size_t beam_width,
+    const timelib::Timer &global_timer) -> std::optional<flexman::core::Solution<State, Resources>>
+{
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    if (steps_per_iteration == 0) {
+        throw std::invalid_argument("steps_per_iteration must be greater than 0");
+    }
+
+    // The minimized objective, and the constrained one.
+    auto minimized = [objective](const solution_t &solution) {
+        return (objective == Objective::Time) ? static_cast<double>(solution.resources.time)
+                                              : static_cast<double>(solution.resources.energy);
+    };
+    auto constrained = [objective](const solution_t &solution) {
+        return (objective == Objective::Time) ? static_cast<double>(solution.resources.energy)
+                                              : static_cast<double>(solution.resources.time);
+    };
+
+    std::vector<solution_t> partials{
+        solution_t{
+            .sequence  = {},
+            .state     = manager->initial_state,
+            .resources = Resources(),
+            .distance  = std::numeric_limits<double>::max(),
+        },
+    };
+    // How promising a partial solution is, the lower the better.
+    const double initial_distance = manager->distance(partials.front());
+    auto score                    = [objective, initial_distance](const solution_t &solution) {
+        if (objective == Objective::Time) {
+            return solution.distance;
+        }
+        const double progress = std::max(initial_distance - solution.distance, std::numeric_limits<double>::epsilon());
+        return static_cast<double>(solution.resources.energy) / progress;
+    };
+
+    std::optional<solution_t> best;
+    std::vector<solution_t> complete;
+    std::vector<solution_t> partial;
+
+    while (!partials.empty() && !global_timer.has_timeout()) {
+        auto extended = flexman::search::extend_solutions<SwitchingMode::Free>(
+            manager, modes, steps_per_iteration, partials, global_timer);
+        complete.clear();
+        partial.clear();
+        flexman::search::split_complete_partial(manager, extended, complete, partial);
+
+        // Keep the best complete solution within the budget.
+        for (auto &solution : complete) {
+            if ((constrained(solution) <= budget) && (!best || (minimized(solution) < minimized(*best)))) {
+                best = std::move(solution);
+            }
+        }
+
+        // Discard the partial solutions exceeding the budget, or the time, or
+        // which are already worse than the best complete solution.
+        partials.clear();
+        for (auto &solution : partial) {
+            if ((constrained(solution) > budget) ||
+                (static_cast<double>(solution.resources.time) > manager->time_max) ||
+                (best && (minimized(solution) >= minimized(*best)))) {
+                continue;
+            }
+            partials.emplace_back(std::move(solution));
+        }
+
+        // Filter the remaining ones.
+        partial = partials;
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Heuristic>(manager, partials, partial);
+
+        // Keep only the most promising ones.
+        if ((beam_width > 0) && (partials.size() > beam_width)) {
+            const auto middle = partials.begin() + static_cast<std::ptrdiff_t>(beam_width);
+            std::nth_element(partials.begin(), middle, partials.end(), [&score](const auto &a, const auto &b) {
+                return score(a) < score(b);
+            });
+            partials.erase(middle, partials.end());
+        }
+    }
+    return best;
+}
+
+/// @brief Builds a Pareto front by ε-constraint decomposition, running the
+/// constrained searches in parallel.
+///
+/// @details First, the minimum time and the minimum energy solutions are
+/// searched; their energies bound the front, or zero does when no solution
+/// fits the time limit of the manager. Then, for each budget of a uniform grid
+/// between them, the minimum time solution within the budget is searched.
+/// When the parameters hold explicit budgets, only those are searched. The
+/// solutions are finally filtered for dominance and duplicates.
+///
+/// The function blocks until the searches it queued complete, even when one of
+/// them throws, since they refer to its locals. Hence, it must not be called
+/// from a task of the same executor, which could wait for itself once all the
+/// workers are busy.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param parameters The parameters of the decomposition.
+/// @param executor The executor running the constrained searches.
+///
+/// @return The Pareto front.
+template <typename State, typename Mode, EnergyTimeResources Resources>
+auto perform_epsilon_constraint_search(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const EpsilonParameters &parameters,
+    flexman::parallel::Executor &executor) -> flexman::core::ParetoFront<State, Resources>
+{
+    using solution_t = flexman::core::Solution<State, Resources>;
+    using future_t   = std::future<std::optional<solution_t>>;
+
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    if (modes.empty()) {
+        throw std::invalid_argument("modes vector is empty");
+    }
+
+    // A stopwatch, shared by all the constrained searches.
+    timelib::Timer global_timer;
+    if (manager->timeout) {
+        global_timer.set_timeout(manager->timeout);
+    }
+    global_timer.start();
+
+    const double unbounded = std::numeric_limits<double>::infinity();
+    const unsigned steps   = parameters.steps_per_iteration;
+    const std::size_t beam = parameters.beam_width;
+
+    // Runs constrained searches on the executor, and collects their solutions.
+    // The searches refer to the timer and to the modes, hence, all of them are
+    // waited for before an exception is rethrown.
+    auto run = [&](const std::vector<std::pair<Objective, double>> &searches) {
+        std::vector<future_t> futures;
+        futures.reserve(searches.size());
+        try {
+            for (const auto &request : searches) {
+                const Objective objective = request.first;
+                const double budget       = request.second;
+                futures.emplace_back(
+                    executor.submit([manager, &modes, objective, budget, steps, beam, &global_timer]() {
+                        return flexman::search::perform_constrained_search(
+                            manager, modes, objective, budget, steps, beam, global_timer);
+                    }));
+            }
+        } catch (...) {
+            for (auto &future : futures) {
+                future.wait();
+            }
+            throw;
+        }
+        for (auto &future : futures) {
+            future.wait();
+        }
+        std::vector<std::optional<solution_t>> found;
+        found.reserve(futures.size());
+        for (auto &future : futures) {
+            found.emplace_back(future.get());
+        }
+        return found;
+    };
+
+    std::vector<solution_t> solutions;
+    std::vector<double> budgets = parameters.budgets;
+
+    // Find the extreme points, and space the budgets between them.
+    if (budgets.empty()) {
+        auto extremes     = run({{Objective::Time, unbounded}, {Objective::Energy, unbounded}});
+        const auto &fast  = extremes[0];
+        const auto &cheap = extremes[1];
+        // Without a cheapest solution within the time limit, the budgets span
+        // from zero, and the infeasible ones find nothing.
+        if (fast) {
+            budgets = flexman::search::energy_budgets(
+                cheap ? static_cast<double>(cheap->resources.energy) : 0.0,
+                static_cast<double>(fast->resources.energy), parameters.points);
+        }
+        for (auto &extreme : extremes) {
+            if (extreme) {
+                solutions.emplace_back(std::move(*extreme));
+            }
+        }
+        qdebug(logging::search, "Found %u extreme points of the front.\n", solutions.size());
+    }
+
+    // Search the budgets in parallel.
+    std::vector<std::pair<Objective, double>> searches;
+    searches.reserve(budgets.size());
+    for (const double budget : budgets) {
+        searches.emplace_back(Objective::Time, budget);
+    }
+    for (auto &solution : run(searches)) {
+        if (solution) {
+            solutions.emplace_back(std::move(*solution));
+        }
+    }
+
+    // Keep the non-dominated ones.
+    flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, solutions);
+    flexman::search::remove_duplicate_solutions(solutions);
+
+    auto pareto_front = flexman::core::ParetoFront<State, Resources>{
+        .solutions           = std::move(solutions),
+        .step_length         = manager->time_delta * static_cast<double>(steps),
+        .steps_per_iteration = steps,
+        .iteration           = static_cast<unsigned>(budgets.size()),
+        .runtime             = global_timer.elapsed().count(),
+        .hypervolume         = 0.0,
+    };
+    if (!pareto_front.solutions.empty()) {
+        pareto_front.hypervolume = flexman::search::hypervolume(
+            pareto_front.solutions, flexman::search::reference_point(pareto_front.solutions));
+    }
+
+    qinfo(
+        logging::search, "Epsilon-constraint search: %u budgets on %u workers, %u solutions in the front (%.3f s).\n",
+        budgets.size(), executor.size(), pareto_front.solutions.size(), pareto_front.runtime);
+
+    return pareto_front;
+}
+
+} // namespace search
+} // namespace flexman
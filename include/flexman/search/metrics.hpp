@@ -0,0 +1,123 @@
+/// @file metrics.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements quality metrics for Pareto fronts.
+///
+/// @details
+/// This file provides the metrics used to measure the quality of a Pareto
+/// front, and to decide when the search has converged. It includes:
+/// - The `EnergyTimeResources` concept, satisfied by resources exposing an
+///   `energy` and a `time` objective.
+/// - The `ReferencePoint` structure and the `reference_point` function, which
+///   derives it from a front.
+/// - The `hypervolume` function, which computes the area dominated by a front
+///   in the energy-time plane, up to the reference point.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "flexman/core/solution.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief Resources that expose the energy and time objectives.
+template <typename Resources>
+concept EnergyTimeResources = requires(const Resources &resources) {
+    { resources.energy } -> std::convertible_to<double>;
+    { resources.time } -> std::convertible_to<double>;
+};
+
+/// @brief The reference point of the hypervolume, in the energy-time plane.
+struct ReferencePoint {
+    /// @brief The energy coordinate.
+    double energy;
+    /// @brief The time coordinate.
+    double time;
+};
+
+/// @brief Derives the reference point of the hypervolume from a front.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param solutions The solutions of the front.
+/// @param margin The relative margin added past the worst energy and time.
+///
+/// @return The reference point.
+template <typename State, EnergyTimeResources Resources>
+auto reference_point(const std::vector<flexman::core::Solution<State, Resources>> &solutions, double margin = 0.1)
+    -> ReferencePoint
+{
+    if (solutions.empty()) {
+        throw std::invalid_argument("cannot derive a reference point from an empty front");
+    }
+    ReferencePoint reference{
+        .energy = static_cast<double>(solutions.front().resources.energy),
+        .time   = static_cast<double>(solutions.front().resources.time),
+    };
+    for (const auto &solution : solutions) {
+        reference.energy = std::max(reference.energy, static_cast<double>(solution.resources.energy));
+        reference.time   = std::max(reference.time, static_cast<double>(solution.resources.time));
+    }
+    reference.energy += std::abs(reference.energy) * margin;
+    reference.time += std::abs(reference.time) * margin;
+    return reference;
+}
+
+/// @brief Computes the hypervolume of a front, i.e., the area of the
+/// energy-time plane dominated by its solutions and bounded by the reference
+/// point. Solutions beyond the reference point do not contribute.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param solutions The solutions of the front.
+/// @param reference The reference point.
+///
+/// @return The hypervolume of the front.
+template <typename State, EnergyTimeResources Resources>
+auto hypervolume(
+    const std::vector<flexman::core::Solution<State, Resources>> &solutions,
+    const ReferencePoint &reference) -> double
+{
+    // Collect the points inside the reference box.
+    std::vector<std::pair<double, double>> points;
+    points.reserve(solutions.size());
+    for (const auto &solution : solutions) {
+        const auto energy = static_cast<double>(solution.resources.energy);
+        const auto time   = static_cast<double>(solution.resources.time);
+        if ((energy < reference.energy) && (time < reference.time)) {
+            points.emplace_back(energy, time);
+        }
+    }
+
+    // Sweep by increasing energy, each point that improves the time adds a
+    // strip up to the reference energy.
+    std::sort(points.begin(), points.end());
+    double volume    = 0.0;
+    double best_time = reference.time;
+    for (const auto &[energy, time] : points) {
+        if (time < best_time) {
+            volume += (reference.energy - energy) * (best_time - time);
+            best_time = time;
+        }
+    }
+    return volume;
+}
+
+} // namespace search
+} // namespace flexman
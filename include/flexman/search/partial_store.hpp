@@ -0,0 +1,553 @@
+/// @file partial_store.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Defines the `PartialStore` container for partial solutions that can
+/// exceed the available memory.
+///
+/// @details
+/// This file provides the `PartialStore` template class, which holds the set of
+/// partial solutions explored by the search. Solutions are kept in an in-memory
+/// buffer until a configurable memory budget is exceeded; at that point the
+/// buffer is sorted by resources and spilled to a run file on local disk, using
+/// a compact binary layout. Runs are read back through `mmap` and merged in
+/// resource order while being consumed, so that extension and dominance
+/// filtering can stream over them without loading the whole set in memory.
+///
+/// Spilling requires both the state and the resources to be trivially
+/// copyable, and it is only available on POSIX systems.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "flexman/core/solution.hpp"
+#include "flexman/logging.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+namespace detail
+{
+
+/// @brief Writes a value to a file.
+///
+/// @tparam T The type of the value, which must be trivially copyable.
+///
+/// @param file the file.
+/// @param value the value to write.
+template <typename T>
+inline void write_value(std::FILE *file, const T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be written");
+    if (std::fwrite(&value, sizeof(T), 1, file) != 1) {
+        throw std::runtime_error("failed to write a binary record");
+    }
+}
+
+/// @brief Reads a value from a memory location.
+///
+/// @tparam T The type of the value, which must be trivially copyable.
+///
+/// @param data the memory location, advanced past the value.
+/// @param value the value to read.
+template <typename T>
+inline void read_value(const unsigned char *&data, T &value) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be read");
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+}
+
+/// @brief Writes a solution to a file, using the layout: resources, distance,
+/// state, sequence length, and the sequence as (mode, times) pairs.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param file the file.
+/// @param solution the solution to write.
+template <typename State, typename Resources>
+inline void write_solution(std::FILE *file, const flexman::core::Solution<State, Resources> &solution)
+{
+    write_value(file, solution.resources);
+    write_value(file, solution.distance);
+    write_value(file, solution.state);
+    write_value(file, static_cast<std::uint32_t>(solution.sequence.size()));
+    for (const auto &execution : solution.sequence) {
+        write_value(file, static_cast<std::uint32_t>(execution.mode));
+        write_value(file, static_cast<std::uint32_t>(execution.times));
+    }
+}
+
+/// @brief Reads a solution written by `write_solution`.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+///
+/// @param data the memory location, advanced past the solution.
+/// @param solution the solution to populate.
+template <typename State, typename Resources>
+inline void read_solution(const unsigned char *&data, flexman::core::Solution<State, Resources> &solution)
+{
+    std::uint32_t length = 0;
+    std::uint32_t mode   = 0;
+    std::uint32_t times  = 0;
+    read_value(data, solution.resources);
+    read_value(data, solution.distance);
+    read_value(data, solution.state);
+    read_value(data, length);
+    solution.sequence.clear();
+    solution.sequence.reserve(length);
+    for (std::uint32_t i = 0; i < length; ++i) {
+        read_value(data, mode);
+        read_value(data, times);
+        solution.sequence.emplace_back(mode, times);
+    }
+}
+
+} // namespace detail
+
+/// @brief Stores partial solutions in memory, spilling sorted runs to disk
+/// when a memory budget is exceeded.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+template <typename State, typename Resources>
+class PartialStore
+{
+public:
+    /// @brief The type of the stored solutions.
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    /// @brief Tells if solutions of this type can be written to disk.
+    static constexpr bool is_spillable = std::is_trivially_copyable_v<State> && std::is_trivially_copyable_v<Resources>;
+
+    /// @brief Constructs the store.
+    ///
+    /// @param memory_limit The memory budget (in bytes) for the in-memory
+    /// buffer, zero disables spilling.
+    /// @param directory The directory where runs are written, when empty the
+    /// system temporary directory is used.
+    explicit PartialStore(std::size_t memory_limit = 0, std::string directory = {})
+        : limit(memory_limit)
+        , path(std::move(directory))
+    {
+        if (limit == 0) {
+            return;
+        }
+#ifdef _WIN32
+        qwarning(logging::search, "Spilling partial solutions is not supported on this platform.\n");
+        limit = 0;
+#else
+        if constexpr (!is_spillable) {
+            throw std::invalid_argument("spilling requires trivially copyable states and resources");
+        }
+        if (path.empty()) {
+            path = std::filesystem::temp_directory_path().string();
+        }
+#endif
+    }
+
+    /// @brief Copy constructor (deleted, runs are owned by a single store).
+    PartialStore(const PartialStore &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, runs are owned by a single store).
+    auto operator=(const PartialStore &other) -> PartialStore & = delete;
+
+    /// @brief Move constructor.
+    ///
+    /// @param other the other instance to move.
+    PartialStore(PartialStore &&other) noexcept
+        : limit(other.limit)
+        , path(std::move(other.path))
+        , buffer_solutions(std::move(other.buffer_solutions))
+        , buffer_bytes(std::exchange(other.buffer_bytes, 0))
+        , runs(std::move(other.runs))
+        , runs_size(std::exchange(other.runs_size, 0))
+    {
+        other.runs.clear();
+    }
+
+    /// @brief Move assignment operator.
+    ///
+    /// @param other the other instance to move.
+    ///
+    /// @return a reference to this instance.
+    auto operator=(PartialStore &&other) noexcept -> PartialStore &
+    {
+        if (this != &other) {
+            this->remove_runs();
+            limit            = other.limit;
+            path             = std::move(other.path);
+            buffer_solutions = std::move(other.buffer_solutions);
+            buffer_bytes     = std::exchange(other.buffer_bytes, 0);
+            runs             = std::move(other.runs);
+            runs_size        = std::exchange(other.runs_size, 0);
+            other.runs.clear();
+        }
+        return *this;
+    }
+
+    /// @brief Destructor, removes the runs still on disk.
+    ~PartialStore() { this->remove_runs(); }
+
+    /// @brief Returns the memory budget of the in-memory buffer.
+    /// @return the memory budget in bytes, zero if spilling is disabled.
+    auto memory_limit() const noexcept -> std::size_t { return limit; }
+
+    /// @brief Returns the directory where runs are written.
+    /// @return the spill directory.
+    auto directory() const noexcept -> const std::string & { return path; }
+
+    /// @brief Returns the total number of stored solutions.
+    /// @return the number of solutions, both in memory and on disk.
+    auto size() const noexcept -> std::size_t { return buffer_solutions.size() + runs_size; }
+
+    /// @brief Checks if the store is empty.
+    /// @return true if there are no solutions, false otherwise.
+    auto empty() const noexcept -> bool { return this->size() == 0; }
+
+    /// @brief Returns the number of runs spilled to disk.
+    /// @return the number of runs.
+    auto spilled_runs() const noexcept -> std::size_t { return runs.size(); }
+
+    /// @brief Returns the number of solutions spilled to disk.
+    /// @return the number of solutions stored in runs.
+    auto spilled_size() const noexcept -> std::size_t { return runs_size; }
+
+    /// @brief Returns the solutions currently held in memory.
+    /// @return a reference to the in-memory buffer.
+    auto buffer() const noexcept -> const std::vector<solution_t> & { return buffer_solutions; }
+
+    /// @brief Estimates the memory used by a solution.
+    ///
+    /// @param solution the solution.
+    ///
+    /// @return the estimated number of bytes.
+    static auto bytes_of(const solution_t &solution) noexcept -> std::size_t
+    {
+        return sizeof(solution_t) + solution.sequence.capacity() * sizeof(flexman::core::ModeExecution);
+    }
+
+    /// @brief Adds a solution to the store, spilling the buffer if the memory
+    /// budget is exceeded.
+    ///
+    /// @param solution the solution to add.
+    void push(solution_t solution)
+    {
+        buffer_bytes += bytes_of(solution);
+        buffer_solutions.emplace_back(std::move(solution));
+        if ((limit > 0) && (buffer_bytes > limit)) {
+            this->spill();
+        }
+    }
+
+    /// @brief Moves all the given solutions inside the store.
+    ///
+    /// @param solutions the solutions to add, the vector is cleared.
+    void append(std::vector<solution_t> &solutions)
+    {
+        // Fast path, when nothing is stored we can just take the vector.
+        if (this->empty() && (limit == 0)) {
+            buffer_solutions.swap(solutions);
+            solutions.clear();
+            return;
+        }
+        for (auto &solution : solutions) {
+            this->push(std::move(solution));
+        }
+        solutions.clear();
+    }
+
+    /// @brief Removes and returns the in-memory buffer.
+    ///
+    /// @return the solutions held in memory.
+    auto take_buffer() -> std::vector<solution_t>
+    {
+        buffer_bytes = 0;
+        return std::exchange(buffer_solutions, {});
+    }
+
+    /// @brief Removes all solutions, both in memory and on disk.
+    void clear()
+    {
+        buffer_solutions.clear();
+        buffer_bytes = 0;
+        this->remove_runs();
+    }
+
+    /// @brief Streams all stored solutions to the given function, in resource
+    /// order when runs are present, and empties the store.
+    ///
+    /// @param function a callable accepting a `solution_t &&`.
+    template <typename Function>
+    void consume(Function &&function)
+    {
+        if (runs.empty()) {
+            auto solutions = this->take_buffer();
+            for (auto &solution : solutions) {
+                function(std::move(solution));
+            }
+            return;
+        }
+#ifndef _WIN32
+        if constexpr (is_spillable) {
+            this->sort_buffer();
+            this->merge_runs(function);
+        }
+#endif
+        this->clear();
+    }
+
+private:
+    /// @brief Header written at the beginning of each run.
+    struct run_header_t {
+        /// @brief Identifies the file as a run.
+        std::uint32_t magic;
+        /// @brief Size of the state, used as a sanity check.
+        std::uint32_t state_size;
+        /// @brief Size of the resources, used as a sanity check.
+        std::uint32_t resources_size;
+        /// @brief Number of solutions in the run.
+        std::uint64_t count;
+    };
+
+    /// @brief A run spilled to disk.
+    struct run_t {
+        /// @brief Path of the run.
+        std::string path;
+        /// @brief Number of solutions in the run.
+        std::size_t count;
+    };
+
+    /// @brief Magic number of run files.
+    static constexpr std::uint32_t run_magic = 0x464d5052U;
+
+    /// @brief Sorts the in-memory buffer by resources.
+    void sort_buffer()
+    {
+        std::sort(buffer_solutions.begin(), buffer_solutions.end(), [](const solution_t &lhs, const solution_t &rhs) {
+            return lhs.resources < rhs.resources;
+        });
+    }
+
+    /// @brief Removes the runs from disk.
+    void remove_runs() noexcept
+    {
+        for (const auto &run : runs) {
+            std::remove(run.path.c_str());
+        }
+        runs.clear();
+        runs_size = 0;
+    }
+
+#ifndef _WIN32
+    /// @brief Sorts the buffer and writes it to a new run on disk.
+    void spill()
+    {
+        if constexpr (is_spillable) {
+            this->sort_buffer();
+            // Create the run file.
+            std::string filename = (std::filesystem::path(path) / "flexman-partials-XXXXXX").string();
+            int fd               = ::mkstemp(filename.data());
+            if (fd < 0) {
+                throw std::runtime_error("failed to create a partial solution run in `" + path + "`");
+            }
+            std::FILE *file = ::fdopen(fd, "wb");
+            if (file == nullptr) {
+                ::close(fd);
+                std::remove(filename.c_str());
+                throw std::runtime_error("failed to open a partial solution run");
+            }
+            try {
+                detail::write_value(
+                    file, run_header_t{
+                              .magic          = run_magic,
+                              .state_size     = static_cast<std::uint32_t>(sizeof(State)),
+                              .resources_size = static_cast<std::uint32_t>(sizeof(Resources)),
+                              .count          = buffer_solutions.size(),
+                          });
+                for (const auto &solution : buffer_solutions) {
+                    detail::write_solution(file, solution);
+                }
+            } catch (...) {
+                std::fclose(file);
+                std::remove(filename.c_str());
+                throw;
+            }
+            if (std::fclose(file) != 0) {
+                std::remove(filename.c_str());
+                throw std::runtime_error("failed to close a partial solution run");
+            }
+            qdebug(
+                logging::search, "Spilled %8u partial solutions (%10u bytes) to `%s`.\n", buffer_solutions.size(),
+                buffer_bytes, filename.c_str());
+            runs.emplace_back(run_t{.path = filename, .count = buffer_solutions.size()});
+            runs_size += buffer_solutions.size();
+            buffer_solutions.clear();
+            buffer_bytes = 0;
+        }
+    }
+
+    /// @brief A cursor over a memory-mapped run.
+    struct cursor_t {
+        /// @brief The mapped memory.
+        void *mapping                   = MAP_FAILED;
+        /// @brief The size of the mapped memory.
+        std::size_t mapping_size        = 0;
+        /// @brief The next record to decode.
+        const unsigned char *data       = nullptr;
+        /// @brief The number of records left to decode.
+        std::size_t remaining           = 0;
+        /// @brief The solutions of the in-memory buffer, when not mapped.
+        std::vector<solution_t> *memory = nullptr;
+        /// @brief Index of the next in-memory solution.
+        std::size_t index               = 0;
+        /// @brief The current solution.
+        solution_t current;
+
+        /// @brief Advances the cursor.
+        /// @return true if a new current solution is available.
+        auto next() -> bool
+        {
+            if (memory != nullptr) {
+                if (index >= memory->size()) {
+                    return false;
+                }
+                current = std::move((*memory)[index++]);
+                return true;
+            }
+            if (remaining == 0) {
+                return false;
+            }
+            detail::read_solution(data, current);
+            --remaining;
+            return true;
+        }
+    };
+
+    /// @brief Maps a run in memory.
+    ///
+    /// @param run the run to map.
+    /// @param cursor the cursor to initialize.
+    static void map_run(const run_t &run, cursor_t &cursor)
+    {
+        int fd = ::open(run.path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("failed to open the partial solution run `" + run.path + "`");
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("failed to stat the partial solution run `" + run.path + "`");
+        }
+        cursor.mapping_size = static_cast<std::size_t>(info.st_size);
+        cursor.mapping      = ::mmap(nullptr, cursor.mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (cursor.mapping == MAP_FAILED) {
+            throw std::runtime_error("failed to map the partial solution run `" + run.path + "`");
+        }
+        ::madvise(cursor.mapping, cursor.mapping_size, MADV_SEQUENTIAL);
+        run_header_t header{};
+        cursor.data = static_cast<const unsigned char *>(cursor.mapping);
+        detail::read_value(cursor.data, header);
+        if ((header.magic != run_magic) || (header.state_size != sizeof(State)) ||
+            (header.resources_size != sizeof(Resources)) || (header.count != run.count)) {
+            ::munmap(cursor.mapping, cursor.mapping_size);
+            cursor.mapping = MAP_FAILED;
+            throw std::runtime_error("the partial solution run `" + run.path + "` is corrupted");
+        }
+        cursor.remaining = run.count;
+    }
+
+    /// @brief Merges the runs and the in-memory buffer in resource order.
+    ///
+    /// @param function the function receiving the solutions.
+    template <typename Function>
+    void merge_runs(Function &function)
+    {
+        // One cursor per run, plus one for the in-memory buffer.
+        std::vector<cursor_t> cursors(runs.size() + 1);
+        auto unmap_all = [&cursors]() {
+            for (auto &cursor : cursors) {
+                if (cursor.mapping != MAP_FAILED) {
+                    ::munmap(cursor.mapping, cursor.mapping_size);
+                    cursor.mapping = MAP_FAILED;
+                }
+            }
+        };
+        try {
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                map_run(runs[i], cursors[i]);
+            }
+            cursors.back().memory = &buffer_solutions;
+            // The heap keeps the cursor with the smallest resources on top.
+            auto greater = [&cursors](std::size_t lhs, std::size_t rhs) {
+                return cursors[rhs].current.resources < cursors[lhs].current.resources;
+            };
+            std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+            for (std::size_t i = 0; i < cursors.size(); ++i) {
+                if (cursors[i].next()) {
+                    heap.push(i);
+                }
+            }
+            while (!heap.empty()) {
+                std::size_t i = heap.top();
+                heap.pop();
+                function(std::move(cursors[i].current));
+                if (cursors[i].next()) {
+                    heap.push(i);
+                }
+            }
+        } catch (...) {
+            unmap_all();
+            throw;
+        }
+        unmap_all();
+    }
+#else
+    /// @brief Spilling is not supported on this platform.
+    void spill() {}
+#endif
+
+    /// @brief The memory budget of the in-memory buffer.
+    std::size_t limit;
+    /// @brief The directory where runs are written.
+    std::string path;
+    /// @brief The in-memory buffer.
+    std::vector<solution_t> buffer_solutions;
+    /// @brief The estimated memory used by the in-memory buffer.
+    std::size_t buffer_bytes = 0;
+    /// @brief The runs spilled to disk.
+    std::vector<run_t> runs;
+    /// @brief The number of solutions stored in runs.
+    std::size_t runs_size = 0;
+};
+
+} // namespace search
+} // namespace flexman
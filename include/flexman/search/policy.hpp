@@ -0,0 +1,441 @@
+/// @file policy.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the policies of the search engine.
+///
+/// @details
+/// The `Search` engine is assembled at compile time from one policy per
+/// category, each one a small type whose functions are inlined into the
+/// iterations of the engine. This file provides the policies, grouped by
+/// category:
+/// - Extension order: `FreeSwitching`, `IncreasingSwitching`, and
+///   `NoSwitching`, which extend the partial solutions with every mode, with
+///   the modes that follow the current one, or with the current mode only.
+/// - Filter of the partial solutions: `KeepPartials`, which keeps them all,
+///   and `HeuristicFilter`, which discards the ones probably dominated by
+///   another partial solution.
+/// - Removal of the duplicate accepted solutions: `SortedDeduplication` and
+///   `NoDeduplication`.
+/// - Overshoot resolver: `InterpolateOvershoot` (see `common.hpp`), which
+///   interpolates the completion point of the completing step, and
+///   `KeepOvershoot`, which keeps the state after the completing step.
+/// - Truncation of the partial solutions: `NoTruncation`, and `KeepClosest`,
+///   which keeps the given number of partial solutions closest to the target.
+/// - Execution of the extensions: `InlineExecution`, and `PooledExecution`,
+///   which extends contiguous chunks of the partial solutions on a pool of
+///   threads shared by the engines, and then concatenates them in order.
+///
+/// Each policy declares its category as `category`, and `select_t` picks the
+/// policy of a category among the ones given to the engine.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/executor.hpp"
+#include "flexman/search/common.hpp"
+
+namespace flexman
+{
+namespace search
+{
+namespace policy
+{
+
+/// @brief Extends the partial solutions with the modes allowed by a switching mode.
+///
+/// @tparam SwitchMode The switching mode.
+template <SwitchingMode SwitchMode>
+struct Switching {
+    /// @brief The category of the policy.
+    using category = extension_tag;
+
+    /// @brief Whether the partial solutions can switch mode.
+    static constexpr bool switches = SwitchMode != SwitchingMode::None;
+
+    /// @brief Extends the partial solutions (see `extend_solutions`).
+    ///
+    /// @tparam Overshoot The policy resolving the overshoot of the completing step.
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The set of modes used to extend the solutions.
+    /// @param steps_per_iteration The number of steps to simulate per iteration.
+    /// @param partials The set of partial solutions to extend.
+    /// @param global_timer The global timer to track the extension process duration.
+    ///
+    /// @return The extended solutions.
+    template <typename Overshoot, typename State, typename Mode, class Resources>
+    static auto extend(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        const unsigned steps_per_iteration,
+        const std::vector<flexman::core::Solution<State, Resources>> &partials,
+        const timelib::Timer &global_timer) -> std::vector<flexman::core::Solution<State, Resources>>
+    {
+        return flexman::search::extend_solutions<SwitchMode, Overshoot>(
+            manager, modes, steps_per_iteration, partials, global_timer);
+    }
+};
+
+/// @brief Extends the partial solutions with every mode.
+using FreeSwitching = Switching<SwitchingMode::Free>;
+/// @brief Extends the partial solutions with their mode and the following ones.
+using IncreasingSwitching = Switching<SwitchingMode::Increasing>;
+/// @brief Extends the partial solutions with their mode only.
+using NoSwitching = Switching<SwitchingMode::None>;
+
+/// @brief Keeps all the partial solutions.
+struct KeepPartials {
+    /// @brief The category of the policy.
+    using category = filter_tag;
+
+    /// @brief Whether the policy discards any partial solution.
+    static constexpr bool filters = false;
+
+    /// @brief Filters the partial solutions.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param partial The partial solutions.
+    ///
+    /// @return The kept partial solutions.
+    template <typename State, typename Mode, class Resources>
+    static auto filter(
+        const flexman::core::Manager<State, Mode, Resources> *,
+        std::vector<flexman::core::Solution<State, Resources>> &&partial)
+        -> std::vector<flexman::core::Solution<State, Resources>>
+    {
+        return std::move(partial);
+    }
+};
+
+/// @brief Discards the partial solutions that are probably dominated by
+/// another partial solution (see `Manager::is_probably_better_than`).
+struct HeuristicFilter {
+    /// @brief The category of the policy.
+    using category = filter_tag;
+
+    /// @brief Whether the policy discards any partial solution.
+    static constexpr bool filters = true;
+
+    /// @brief Filters the partial solutions.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param partial The partial solutions.
+    ///
+    /// @return The kept partial solutions.
+    template <typename State, typename Mode, class Resources>
+    static auto filter(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        std::vector<flexman::core::Solution<State, Resources>> &&partial)
+        -> std::vector<flexman::core::Solution<State, Resources>>
+    {
+        auto kept = partial;
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Heuristic>(manager, kept, partial);
+        return kept;
+    }
+};
+
+/// @brief Removes the duplicate accepted solutions (see `remove_duplicate_solutions`).
+struct SortedDeduplication {
+    /// @brief The category of the policy.
+    using category = deduplication_tag;
+
+    /// @brief Removes the duplicate solutions.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param solutions The solutions.
+    template <typename State, class Resources>
+    static void apply(std::vector<flexman::core::Solution<State, Resources>> &solutions)
+    {
+        flexman::search::remove_duplicate_solutions(solutions);
+    }
+};
+
+/// @brief Keeps the duplicate accepted solutions, e.g., when the dominance
+/// relation of the manager already discards them.
+struct NoDeduplication {
+    /// @brief The category of the policy.
+    using category = deduplication_tag;
+
+    /// @brief Keeps the solutions as they are.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Resources The type representing the resources.
+    template <typename State, class Resources>
+    static void apply(std::vector<flexman::core::Solution<State, Resources>> &)
+    {
+    }
+};
+
+/// @brief Keeps the solution after the completing step, without looking for
+/// the completion point.
+struct KeepOvershoot {
+    /// @brief The category of the policy.
+    using category = overshoot_tag;
+
+    /// @brief Resolves the overshoot.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param current The solution after the completing step.
+    ///
+    /// @return The completed solution.
+    template <typename State, typename Mode, class Resources>
+    static auto resolve(
+        const flexman::core::Manager<State, Mode, Resources> *,
+        const flexman::core::Solution<State, Resources> &,
+        const flexman::core::Solution<State, Resources> &current) -> flexman::core::Solution<State, Resources>
+    {
+        return current;
+    }
+};
+
+/// @brief Keeps all the partial solutions.
+struct NoTruncation {
+    /// @brief The category of the policy.
+    using category = truncation_tag;
+
+    /// @brief Truncates the partial solutions.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Resources The type representing the resources.
+    template <typename State, class Resources>
+    static void apply(std::vector<flexman::core::Solution<State, Resources>> &)
+    {
+    }
+};
+
+/// @brief Keeps the partial solutions closest to the target, as a beam search.
+///
+/// @tparam Count The number of partial solutions kept.
+template <std::size_t Count>
+struct KeepClosest {
+    static_assert(Count > 0, "KeepClosest must keep at least one partial solution");
+
+    /// @brief The category of the policy.
+    using category = truncation_tag;
+
+    /// @brief Truncates the partial solutions.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param partial The partial solutions.
+    template <typename State, class Resources>
+    static void apply(std::vector<flexman::core::Solution<State, Resources>> &partial)
+    {
+        if (partial.size() <= Count) {
+            return;
+        }
+        std::stable_sort(partial.begin(), partial.end(), [](const auto &lhs, const auto &rhs) {
+            return std::abs(lhs.distance) < std::abs(rhs.distance);
+        });
+        partial.erase(partial.begin() + static_cast<std::ptrdiff_t>(Count), partial.end());
+    }
+};
+
+/// @brief Extends the partial solutions on the calling thread.
+struct InlineExecution {
+    /// @brief The category of the policy.
+    using category = execution_tag;
+
+    /// @brief Extends the partial solutions.
+    ///
+    /// @tparam Solution The type of the solutions.
+    /// @tparam Extend The type of the extension, called as `extend(partials)`.
+    ///
+    /// @param partials The partial solutions.
+    /// @param extend The extension.
+    ///
+    /// @return The extended solutions.
+    template <typename Solution, typename Extend>
+    auto run(std::vector<Solution> &partials, const Extend &extend) -> std::vector<Solution>
+    {
+        return extend(partials);
+    }
+};
+
+/// @brief Extends contiguous chunks of the partial solutions on a pool of
+/// threads, and concatenates them in order, hence, the extended solutions are
+/// the ones of `InlineExecution`. The manager must support concurrent calls of
+/// its const functions.
+///
+/// @details The threads are not owned by the policy, so that building an
+/// engine for each search, as the `perform_search` functions do, does not
+/// start and join a pool each time. By default, all the policies with the
+/// same number of workers share a pool of the process, started on first use;
+/// otherwise, they run on the executor given on construction. In both cases,
+/// a search must not run on a task of the same executor, as it waits for the
+/// extensions it submits.
+///
+/// @tparam Workers The number of threads of the shared pool, zero uses one
+/// per hardware thread.
+template <std::size_t Workers = 0>
+class PooledExecution
+{
+public:
+    /// @brief The category of the policy.
+    using category = execution_tag;
+
+    /// @brief Runs on the pool of the process with the given number of workers.
+    PooledExecution()
+        : executor(&PooledExecution::shared_executor())
+    {
+    }
+
+    /// @brief Runs on the given executor, which must outlive the policy.
+    ///
+    /// @param _executor The executor running the extensions.
+    explicit PooledExecution(flexman::parallel::Executor &_executor)
+        : executor(&_executor)
+    {
+    }
+
+    /// @brief Extends the partial solutions, which are moved into the chunks.
+    ///
+    /// @tparam Solution The type of the solutions.
+    /// @tparam Extend The type of the extension, called as `extend(partials)`.
+    ///
+    /// @param partials The partial solutions.
+    /// @param extend The extension.
+    ///
+    /// @return The extended solutions.
+    template <typename Solution, typename Extend>
+    auto run(std::vector<Solution> &partials, const Extend &extend) -> std::vector<Solution>
+    {
+        const std::size_t count = std::min(executor->size(), partials.size());
+        if (count <= 1) {
+            return extend(partials);
+        }
+        // Split the partial solutions in contiguous chunks.
+        std::vector<std::vector<Solution>> chunks(count);
+        for (std::size_t chunk = 0, first = 0; chunk < count; ++chunk) {
+            const std::size_t size = (partials.size() / count) + ((chunk < (partials.size() % count)) ? 1 : 0);
+            chunks[chunk].assign(
+                std::make_move_iterator(partials.begin() + static_cast<std::ptrdiff_t>(first)),
+                std::make_move_iterator(partials.begin() + static_cast<std::ptrdiff_t>(first + size)));
+            first += size;
+        }
+        partials.clear();
+        // Extend them in parallel.
+        std::vector<std::future<std::vector<Solution>>> futures;
+        futures.reserve(count);
+        try {
+            for (auto &chunk : chunks) {
+                futures.emplace_back(executor->submit([&extend, &chunk]() { return extend(chunk); }));
+            }
+        } catch (...) {
+            // The submitted tasks refer to the chunks, let them finish first.
+            for (auto &future : futures) {
+                future.wait();
+            }
+            throw;
+        }
+        // Wait for all of them, as the chunks must outlive the tasks even if one throws.
+        for (auto &future : futures) {
+            future.wait();
+        }
+        // Concatenate them in order.
+        std::vector<Solution> solutions;
+        for (auto &future : futures) {
+            auto extended = future.get();
+            flexman::search::move_elements(extended, solutions);
+        }
+        return solutions;
+    }
+
+private:
+    /// @brief Returns the pool of the process with the given number of workers.
+    ///
+    /// @return The executor, started on the first call.
+    static auto shared_executor() -> flexman::parallel::Executor &
+    {
+        static flexman::parallel::Executor shared(Workers);
+        return shared;
+    }
+
+    /// @brief The pool of threads, not owned.
+    flexman::parallel::Executor *executor;
+};
+
+/// @brief Support functions.
+namespace detail
+{
+
+/// @brief Selects the policy of a category.
+///
+/// @tparam Category The category.
+/// @tparam Default The policy used when none of the given ones has the category.
+/// @tparam Policies The given policies.
+template <typename Category, typename Default, typename... Policies>
+struct select {
+    /// @brief The selected policy.
+    using type = Default;
+};
+
+/// @brief Selects the policy of a category, by checking the first policy.
+///
+/// @tparam Category The category.
+/// @tparam Default The policy used when none of the given ones has the category.
+/// @tparam First The first policy.
+/// @tparam Rest The other policies.
+template <typename Category, typename Default, typename First, typename... Rest>
+struct select<Category, Default, First, Rest...> {
+    /// @brief The selected policy.
+    using type = std::conditional_t<
+        std::is_same_v<typename First::category, Category>,
+        First,
+        typename select<Category, Default, Rest...>::type>;
+};
+
+} // namespace detail
+
+/// @brief The policy of a category among the given ones, or the default one.
+///
+/// @tparam Category The category.
+/// @tparam Default The policy used when none of the given ones has the category.
+/// @tparam Policies The given policies.
+template <typename Category, typename Default, typename... Policies>
+using select_t = typename detail::select<Category, Default, Policies...>::type;
+
+/// @brief The number of the given policies with a category.
+///
+/// @tparam Category The category.
+/// @tparam Policies The given policies.
+template <typename Category, typename... Policies>
+inline constexpr std::size_t count_v =
+    (std::size_t{0} + ... + (std::is_same_v<typename Policies::category, Category> ? 1U : 0U));
+
+} // namespace policy
+} // namespace search
+} // namespace flexman
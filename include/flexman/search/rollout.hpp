@@ -0,0 +1,124 @@
+/// @file rollout.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the greedy rollout of partial solutions.
+///
+/// @details
+/// In the first iterations of a search, no partial solution is complete yet,
+/// hence, the set of accepted solutions is empty and nothing is pruned by
+/// dominance. A rollout completes a sample of the most promising partial
+/// solutions with a default policy, i.e., staying in their current mode until
+/// they reach the target, and accepts the complete solutions it obtains. The
+/// partial solutions are left untouched, but from then on, the ones dominated
+/// by a rolled out solution are discarded.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief Completes a sample of partial solutions by staying in their current
+/// mode, and accepts the complete solutions obtained.
+///
+/// @details The sampled partial solutions are the ones closest to the target.
+/// Each one is simulated in its last mode, in a single call, for the steps left
+/// before the maximum time of the manager; hence, managers supporting the fast
+/// advance complete it in one go. The rollouts that do not reach the target
+/// are dropped.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The set of modes available for simulation.
+/// @param partial_solutions The partial solutions to sample.
+/// @param samples The maximum number of partial solutions to complete.
+/// @param accepted_solutions The set of accepted solutions (Pareto front).
+/// @param global_timer The global timer to track the search process duration.
+///
+/// @return The number of rollouts that reached the target.
+template <typename State, typename Mode, typename Resources>
+auto rollout_partial_solutions(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const std::vector<flexman::core::Solution<State, Resources>> &partial_solutions,
+    std::size_t samples,
+    std::vector<flexman::core::Solution<State, Resources>> &accepted_solutions,
+    const timelib::Timer &global_timer) -> std::size_t
+{
+    // Check if manager is a valid pointer.
+    if (!manager) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+
+    // Select the partial solutions closest to the target.
+    std::vector<std::size_t> order(partial_solutions.size());
+    std::iota(order.begin(), order.end(), 0);
+    samples           = std::min(samples, order.size());
+    const auto middle = order.begin() + static_cast<std::ptrdiff_t>(samples);
+    std::partial_sort(order.begin(), middle, order.end(), [&partial_solutions](std::size_t a, std::size_t b) {
+        return partial_solutions[a].distance < partial_solutions[b].distance;
+    });
+
+    // The number of steps that fit the maximum time.
+    const auto max_steps = static_cast<std::size_t>(std::ceil(manager->time_max / manager->time_delta));
+
+    std::vector<flexman::core::Solution<State, Resources>> complete;
+    for (auto it = order.begin(); (it != middle) && !global_timer.has_timeout(); ++it) {
+        const auto &partial = partial_solutions[*it];
+        if (partial.sequence.empty()) {
+            continue;
+        }
+        // Count the steps already simulated.
+        std::size_t steps = 0;
+        for (const auto &execution : partial.sequence) {
+            steps += execution.times;
+        }
+        if (steps >= max_steps) {
+            continue;
+        }
+        // Stay in the current mode until the target, or the maximum time.
+        auto solution = flexman::search::simulate_mode(
+            manager, modes[partial.sequence.back().mode], static_cast<unsigned>(max_steps - steps), partial);
+        if (manager->is_complete(solution)) {
+            complete.emplace_back(std::move(solution));
+        }
+    }
+
+    // Accept the complete solutions.
+    const std::size_t completed = complete.size();
+    if (completed > 0) {
+        flexman::search::move_elements(complete, accepted_solutions);
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, accepted_solutions);
+        flexman::search::remove_duplicate_solutions(accepted_solutions);
+    }
+    qdebug_async(
+        logging::search, "[%8u] Rolled out %u partial solutions, %u reached the target.\n", partial_solutions.size(),
+        samples, completed);
+    return completed;
+}
+
+} // namespace search
+} // namespace flexman
@@ -4,14 +4,26 @@
 /// @brief Implements the main search functions for solution optimization.
 ///
 /// @details
-/// This file provides core search functions for iteratively improving solutions
-/// using different search algorithms. It includes:
-/// - The `perform_search_single_iteration` function, which extends and refines
-///   solutions within a single search step.
-/// - The `perform_search_n_iterations` function, which executes multiple search
-///   iterations to generate an optimized Pareto front.
-/// - The `perform_search` function, which manages the full search process,
-///   iteratively refining solutions with configurable step sizes.
+/// This file provides the `Search` engine, which iteratively improves solutions,
+/// and whose behaviour is assembled at compile time from the policies of
+/// `policy.hpp`. Its members are:
+/// - `single_iteration`, which extends and refines solutions within a single
+///   search step.
+/// - `n_iterations`, which executes multiple search iterations to generate an
+///   optimized Pareto front.
+/// - `run`, which manages the full search process, iteratively refining
+///   solutions with configurable step sizes, and which can stop once the
+///   hypervolume of the fronts stops improving.
+///
+/// The `perform_search_single_iteration`, `perform_search_n_iterations`, and
+/// `perform_search` functions run the engine preset for a `SearchAlgorithm`
+/// (see `SearchPreset`).
+///
+/// The single-machine search skips the generic iterations, and simulates each
+/// mode alone (see `perform_single_machine_n_iterations`).
+///
+/// Partial solutions are kept in a `PartialStore`, which spills them to disk
+/// when the memory budget set in the `SearchParameters` is exceeded.
 ///
 /// The search functions leverage a variety of algorithms and heuristics to
 /// explore and optimize the solution space efficiently. The process involves
@@ -30,9 +42,19 @@
 #include "flexman/core/solution.hpp"
 #include "flexman/logging.hpp"
 #include "flexman/search/common.hpp"
+#include "flexman/search/cost_model.hpp"
+#include "flexman/search/metrics.hpp"
+#include "flexman/search/partial_store.hpp"
+#include "flexman/search/policy.hpp"
+#include "flexman/search/rollout.hpp"
+#include "flexman/search/single_machine.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <timelib/timer.hpp>
 
 namespace flexman
@@ -47,86 +69,731 @@ namespace flexman
 namespace search
 {
 
-/// @brief Performs a single iteration of the search process.
+/// @brief The search engine, assembled from one policy per category.
+///
+/// @details The policies are the types of `policy.hpp`, given in any order;
+/// a category without a policy gets its default one, i.e., `FreeSwitching`,
+/// `KeepPartials`, `SortedDeduplication`, `InterpolateOvershoot`,
+/// `NoTruncation`, and `InlineExecution`. For instance,
+/// `Search<policy::HeuristicFilter, policy::PooledExecution<>>` is the
+/// heuristic search, extending the partial solutions in parallel.
+///
+/// @tparam Policies The policies.
+template <typename... Policies>
+class Search
+{
+    static_assert(
+        (policy::count_v<policy::extension_tag, Policies...> + policy::count_v<policy::filter_tag, Policies...> +
+         policy::count_v<policy::deduplication_tag, Policies...> + policy::count_v<policy::overshoot_tag, Policies...> +
+         policy::count_v<policy::truncation_tag, Policies...> + policy::count_v<policy::execution_tag, Policies...>) ==
+            sizeof...(Policies),
+        "every policy must belong to a category of policy.hpp");
+    static_assert(
+        (policy::count_v<policy::extension_tag, Policies...> <= 1) &&
+            (policy::count_v<policy::filter_tag, Policies...> <= 1) &&
+            (policy::count_v<policy::deduplication_tag, Policies...> <= 1) &&
+            (policy::count_v<policy::overshoot_tag, Policies...> <= 1) &&
+            (policy::count_v<policy::truncation_tag, Policies...> <= 1) &&
+            (policy::count_v<policy::execution_tag, Policies...> <= 1),
+        "at most one policy per category");
+
+public:
+    /// @brief The policy setting the order of the extensions.
+    using extension_policy     = policy::select_t<policy::extension_tag, policy::FreeSwitching, Policies...>;
+    /// @brief The policy filtering the partial solutions.
+    using filter_policy        = policy::select_t<policy::filter_tag, policy::KeepPartials, Policies...>;
+    /// @brief The policy removing the duplicate accepted solutions.
+    using deduplication_policy = policy::select_t<policy::deduplication_tag, policy::SortedDeduplication, Policies...>;
+    /// @brief The policy resolving the overshoot of the completing step.
+    using overshoot_policy     = policy::select_t<policy::overshoot_tag, policy::InterpolateOvershoot, Policies...>;
+    /// @brief The policy truncating the partial solutions.
+    using truncation_policy    = policy::select_t<policy::truncation_tag, policy::NoTruncation, Policies...>;
+    /// @brief The policy running the extensions.
+    using execution_policy     = policy::select_t<policy::execution_tag, policy::InlineExecution, Policies...>;
+
+    /// @brief Constructs the engine with the default execution policy.
+    Search() = default;
+
+    /// @brief Constructs the engine with the given execution policy, e.g., a
+    /// `PooledExecution` running on an executor of the caller.
+    ///
+    /// @param _execution The execution policy.
+    explicit Search(execution_policy _execution)
+        : execution(std::move(_execution))
+    {
+    }
+
+    /// @brief Whether the engine is the single-machine search, which can
+    /// simulate each mode alone (see `perform_single_machine_n_iterations`).
+    static constexpr bool single_machine =
+        std::is_same_v<extension_policy, policy::NoSwitching> && std::is_same_v<filter_policy, policy::KeepPartials> &&
+        std::is_same_v<deduplication_policy, policy::SortedDeduplication> &&
+        std::is_same_v<overshoot_policy, policy::InterpolateOvershoot> &&
+        std::is_same_v<truncation_policy, policy::NoTruncation>;
+
+    /// @brief Performs a single iteration of the search process.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The set of modes available for simulation.
+    /// @param steps_per_iteration The number of steps simulated in this iteration.
+    /// @param partial_solutions The set of partial solutions to extend.
+    /// @param accepted_solutions The set of accepted solutions (Pareto front).
+    /// @param global_timer The global timer to track the search process duration.
+    /// @param cost_model Optional model of the remaining cost, used to prune and
+    /// order the partial solutions.
+    /// @param counters Optional hardware counters, where the phases are measured.
+    template <typename State, typename Mode, typename Resources>
+    void single_iteration(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        const unsigned steps_per_iteration,
+        std::vector<flexman::core::Solution<State, Resources>> &partial_solutions,
+        std::vector<flexman::core::Solution<State, Resources>> &accepted_solutions,
+        const timelib::Timer &global_timer,
+        const CostModel *cost_model = nullptr,
+        SearchCounters *counters    = nullptr)
+    {
+        // Check if manager is a valid pointer.
+        if (!manager) {
+            throw std::invalid_argument("manager pointer is null");
+        }
+
+        // Check if steps_per_iteration is a positive number.
+        if (steps_per_iteration == 0) {
+            throw std::invalid_argument("steps_per_iteration must be greater than 0");
+        }
+
+        // Check if modes vector is not empty.
+        if (modes.empty()) {
+            throw std::invalid_argument("modes vector is empty");
+        }
+
+        std::vector<flexman::core::Solution<State, Resources>> complete;
+        std::vector<flexman::core::Solution<State, Resources>> partial;
+        std::vector<flexman::core::Solution<State, Resources>> extended;
+
+        // Measures the phases, if requested.
+        PhaseRecorder recorder(counters);
+
+        // First, we need t extend the partial solutions we have. The execution
+        // policy may extend them on other threads, hence, each extension is
+        // measured by the thread that runs it.
+        extended = execution.run(partial_solutions, [&](const auto &partials) {
+            PhaseRecorder extension_recorder(counters);
+            extension_recorder.start();
+            auto solutions = extension_policy::template extend<overshoot_policy>(
+                manager, modes, steps_per_iteration, partials, global_timer);
+            extension_recorder.stop(SearchPhase::Extension, solutions.size());
+            return solutions;
+        });
+        flexman::search::log_solutions(logging::solution, quire::debug, extended);
+
+        // Remove the dominated solutions from the Pareto front.
+        recorder.start();
+        std::size_t filtered = extended.size();
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, extended, accepted_solutions);
+        recorder.stop(SearchPhase::Dominance, filtered);
+        flexman::search::log_solutions(logging::solution, quire::debug, extended);
+
+        // We split between complete solutions and partial ones.
+        recorder.start();
+        const std::size_t split = extended.size();
+        flexman::search::split_complete_partial(manager, extended, complete, partial);
+        recorder.stop(SearchPhase::Split, split);
+
+        // We need to save complete solutions.
+        if (!complete.empty()) {
+            recorder.start();
+            // Move solutions from `complete` to `accepted_solutions`.
+            flexman::search::move_elements(complete, accepted_solutions);
+            filtered = accepted_solutions.size();
+            // Remove dominated solutions.
+            flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, accepted_solutions);
+            // Then we need to remove duplicate solutions.
+            deduplication_policy::apply(accepted_solutions);
+            recorder.stop(SearchPhase::Dominance, filtered);
+        }
+
+        // Prune and order the partial solutions with the cost model.
+        if constexpr (CostFeatureState<State> && EnergyTimeResources<Resources>) {
+            if ((cost_model != nullptr) && !cost_model->empty() && !partial.empty()) {
+                recorder.start();
+                const std::size_t scored = partial.size();
+                const auto pruned =
+                    flexman::search::prune_with_cost_model(manager, *cost_model, partial, accepted_solutions);
+                recorder.stop(SearchPhase::Pruning, scored);
+                qdebug_async(logging::common, "[%8u] Pruned by the cost model: %8u.\n", partial.size(), pruned);
+            }
+        }
+
+        // Filter the partial solutions among themselves.
+        if constexpr (filter_policy::filters) {
+            recorder.start();
+            filtered          = partial.size();
+            partial_solutions = filter_policy::filter(manager, std::move(partial));
+            recorder.stop(SearchPhase::Dominance, filtered);
+        } else {
+            // Update the list of partial solutions.
+            partial_solutions = filter_policy::filter(manager, std::move(partial));
+        }
+
+        // Truncate the partial solutions.
+        truncation_policy::apply(partial_solutions);
+    }
+
+    /// @brief Performs a single iteration of the search process over a store of
+    /// partial solutions.
+    ///
+    /// @details When all partial solutions fit in memory, this is equivalent to the
+    /// vector-based iteration. Otherwise, the spilled runs are streamed in
+    /// resource order and processed in chunks that fit the memory budget, and the
+    /// surviving partial solutions are written to a new store. In that case, the
+    /// filter and the truncation of the partial solutions are applied within each
+    /// chunk.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The set of modes available for simulation.
+    /// @param steps_per_iteration The number of steps simulated in this iteration.
+    /// @param partial_solutions The store of partial solutions to extend.
+    /// @param accepted_solutions The set of accepted solutions (Pareto front).
+    /// @param global_timer The global timer to track the search process duration.
+    /// @param cost_model Optional model of the remaining cost, used to prune and
+    /// order the partial solutions.
+    /// @param counters Optional hardware counters, where the phases are measured.
+    template <typename State, typename Mode, typename Resources>
+    void single_iteration(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        const unsigned steps_per_iteration,
+        flexman::search::PartialStore<State, Resources> &partial_solutions,
+        std::vector<flexman::core::Solution<State, Resources>> &accepted_solutions,
+        const timelib::Timer &global_timer,
+        const CostModel *cost_model = nullptr,
+        SearchCounters *counters    = nullptr)
+    {
+        // If nothing was spilled, we can work directly in memory.
+        if (partial_solutions.spilled_runs() == 0) {
+            auto partials = partial_solutions.take_buffer();
+            this->single_iteration(
+                manager, modes, steps_per_iteration, partials, accepted_solutions, global_timer, cost_model, counters);
+            partial_solutions.append(partials);
+            return;
+        }
+
+        qdebug(
+            logging::search, "[%8u] Streaming partial solutions from %u runs.\n", partial_solutions.size(),
+            partial_solutions.spilled_runs());
+
+        // The store receiving the surviving partial solutions.
+        flexman::search::PartialStore<State, Resources> next_partials(
+            partial_solutions.memory_limit(), partial_solutions.directory());
+
+        // Each partial solution is extended with every mode, hence, we size the
+        // chunks so that their extension fits the memory budget.
+        const std::size_t chunk_limit = std::max<std::size_t>(partial_solutions.memory_limit() / (modes.size() + 1), 1);
+
+        std::vector<flexman::core::Solution<State, Resources>> chunk;
+        std::size_t chunk_bytes = 0;
+
+        // Processes the current chunk and moves the surviving partials.
+        auto process_chunk = [&]() {
+            this->single_iteration(
+                manager, modes, steps_per_iteration, chunk, accepted_solutions, global_timer, cost_model, counters);
+            next_partials.append(chunk);
+            chunk_bytes = 0;
+        };
+
+        partial_solutions.consume([&](flexman::core::Solution<State, Resources> &&solution) {
+            // Once we timed out, the remaining partial solutions are dropped.
+            if (global_timer.has_timeout()) {
+                return;
+            }
+            chunk_bytes += flexman::search::PartialStore<State, Resources>::bytes_of(solution);
+            chunk.emplace_back(std::move(solution));
+            if (chunk_bytes >= chunk_limit) {
+                process_chunk();
+            }
+        });
+        if (!chunk.empty()) {
+            process_chunk();
+        }
+
+        // Replace the partial solutions.
+        partial_solutions = std::move(next_partials);
+    }
+
+    /// @brief Performs multiple iterations of the search process.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The set of modes available for simulation.
+    /// @param steps_per_iteration The number of steps simulated per iteration.
+    /// @param previous_pareto_front The previous Pareto front of solutions, whose
+    /// solutions are moved into the returned front; pass it as an rvalue to avoid
+    /// copying them.
+    /// @param global_timer The global timer to track the search process duration.
+    /// @param parameters The search parameters.
+    /// @param exchange Optional callback invoked with the accepted solutions after
+    /// each iteration, which can be used to share them with other searches.
+    ///
+    /// @return The updated Pareto front after performing the iterations.
+    template <typename State, typename Mode, typename Resources>
+    auto n_iterations(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const std::vector<Mode> &modes,
+        const unsigned steps_per_iteration,
+        flexman::core::ParetoFront<State, Resources> previous_pareto_front,
+        const timelib::Timer &global_timer,
+        const SearchParameters &parameters = SearchParameters(),
+        const std::function<void(std::vector<flexman::core::Solution<State, Resources>> &)> &exchange = {})
+        -> flexman::core::ParetoFront<State, Resources>
+    {
+        // Check if manager is a valid pointer.
+        if (!manager) {
+            throw std::invalid_argument("manager pointer is null");
+        }
+
+        // Check if steps_per_iteration is a positive number.
+        if (steps_per_iteration == 0) {
+            throw std::invalid_argument("steps_per_iteration must be greater than 0");
+        }
+
+        // Check if total_iterations is a positive number.
+        if (steps_per_iteration == 0) {
+            throw std::invalid_argument("total_iterations must be greater than 0");
+        }
+
+        // Check if modes vector is not empty.
+        if (modes.empty()) {
+            throw std::invalid_argument("modes vector is empty");
+        }
+
+        // Reset the outcome of the checkpoint.
+        cancelled = false;
+
+        // Without switching, the modes can be simulated alone.
+        if constexpr (single_machine) {
+            if (flexman::search::supports_single_machine_fast_path(parameters, static_cast<bool>(exchange))) {
+                auto pareto_front = flexman::search::perform_single_machine_n_iterations(
+                    manager, modes, steps_per_iteration, std::move(previous_pareto_front), global_timer, parameters);
+                // The fast path has no boundary between the iterations, only at the end.
+                cancelled = parameters.checkpoint && !parameters.checkpoint();
+                return pareto_front;
+            }
+        }
+
+        // Prepare the initial partial solutions.
+        flexman::search::PartialStore<State, Resources> partial_solutions(
+            parameters.partial_memory_limit, parameters.spill_directory);
+        // Iterate over the modes.
+        for (const auto &mode : modes) {
+            // Skip the modes we are not allowed to start from.
+            if (!parameters.initial_modes.empty() &&
+                std::find(parameters.initial_modes.begin(), parameters.initial_modes.end(), mode.id) ==
+                    parameters.initial_modes.end()) {
+                continue;
+            }
+            partial_solutions.push(
+                // Initial solution.
+                flexman::core::Solution<State, Resources>{
+                    .sequence  = {{mode.id, 0}},                     // Empty sequence initially.
+                    .state     = manager->initial_state,             // Start from the initial state.
+                    .resources = Resources(),                        // Initialize resources.
+                    .distance  = std::numeric_limits<double>::max(), // Initialize the distance to maximum.
+                });
+        }
+
+        // The cost model needs states with indexable components, and resources
+        // with energy and time.
+        if constexpr (!CostFeatureState<State> || !EnergyTimeResources<Resources>) {
+            if (parameters.cost_model) {
+                qwarning(logging::search, "The cost model is not supported by these states and resources.\n");
+            }
+        }
+
+        // Prepare the accepted solutions from the previous Pareto front.
+        std::vector<flexman::core::Solution<State, Resources>> accepted_solutions =
+            std::move(previous_pareto_front.solutions);
+
+        // A stopwatch to check runtime.
+        timelib::Timer pareto_timer;
+        timelib::Timer round_timer;
+
+        // Start the pareto timer.
+        pareto_timer.start();
+
+        // Calculate the time covered in each iteration.
+        const double time_per_iteration = manager->time_delta * static_cast<double>(steps_per_iteration);
+
+        // Determine the maximum number of steps allowed.
+        const auto max_iterations = static_cast<unsigned>(manager->time_max / time_per_iteration);
+
+        qinfo(
+            logging::round, "\nPerform %6u iterations maximum, with %5u steps per iteration, each simulating %7.2f.\n",
+            max_iterations, steps_per_iteration, time_per_iteration);
+
+        // Perform the search for the specified number of steps or until no partial solutions remain.
+        unsigned iteration = 0;
+        while ((iteration < max_iterations) && !partial_solutions.empty()) {
+            // Start the round timer.
+            round_timer.start();
+
+            // Complete a sample of the partial solutions, to prune with them.
+            if (parameters.rollout_samples > 0) {
+                flexman::search::rollout_partial_solutions(
+                    manager, modes, partial_solutions.buffer(), parameters.rollout_samples, accepted_solutions,
+                    global_timer);
+            }
+
+            // Perform a single iteration of the search process.
+            this->single_iteration(
+                manager, modes, steps_per_iteration, partial_solutions, accepted_solutions, global_timer,
+                parameters.cost_model.get(), parameters.counters.get());
+
+            ++iteration;
+
+            // Share the accepted solutions, if requested.
+            if (exchange) {
+                exchange(accepted_solutions);
+            }
+
+            qinfo(logging::round, "Step: %6d/%-6d, ", iteration, max_iterations);
+            qinfo(logging::round, "Part: %6d, ", partial_solutions.size());
+            qinfo(logging::round, "Full: %6d, ", accepted_solutions.size());
+            if (partial_solutions.spilled_runs() > 0) {
+                qinfo(logging::round, "Disk: %6d, ", partial_solutions.spilled_size());
+            }
+            qinfo(logging::round, "RndTm: %8.3f s, ", round_timer.elapsed().count());
+            qinfo(logging::round, "RunTm: %8.3f s , ", global_timer.elapsed().count());
+            qinfo(logging::round, "RemTm: %8.3f s\r", global_timer.remaining().count());
+            if ((iteration == max_iterations) || partial_solutions.empty()) {
+                qinfo(logging::round, "\n");
+            }
+
+            qdebug(logging::solution, "Accepted solutions:\n");
+            flexman::search::log_solutions(logging::solution, quire::debug, accepted_solutions);
+            qdebug(logging::solution, "Partial solutions:\n");
+            flexman::search::log_solutions(logging::solution, quire::debug, partial_solutions.buffer());
+
+            if (global_timer.has_timeout()) {
+                qwarning(
+                    logging::round,
+                    "Iteration index %2u of %3u (Steps: %d, Length: %.2f), went into timeout (%.2f > %.2f).\n",
+                    iteration, max_iterations, steps_per_iteration, time_per_iteration,
+                    global_timer.elapsed().count(), manager->timeout.count());
+                break;
+            }
+
+            // Let the scheduler pause, or stop, the search.
+            if (parameters.checkpoint && !parameters.checkpoint()) {
+                qinfo(
+                    logging::round, "\nIteration index %2u of %3u, stopped by the checkpoint.\n", iteration,
+                    max_iterations);
+                cancelled = true;
+                break;
+            }
+        }
+
+        // Return the updated Pareto front after performing the iterations.
+        return flexman::core::ParetoFront<State, Resources>{
+            .solutions           = std::move(accepted_solutions),  // The final set of accepted solutions.
+            .step_length         = time_per_iteration,             // The length of each iteration.
+            .steps_per_iteration = steps_per_iteration,            // The number of steps per iteration.
+            .iteration           = iteration,                      // The total number of iterations performed.
+            .runtime             = pareto_timer.elapsed().count(), // The runtime of the search process.
+            .hypervolume         = 0.0,                            // Computed by the caller, if needed.
+        };
+    }
+
+    /// @brief Performs a search using the given parameters and modes, starting
+    /// from a seed Pareto front.
+    ///
+    /// @tparam State The type representing the state.
+    /// @tparam Mode The type representing the mode.
+    /// @tparam Resources The type representing the resources.
+    ///
+    /// @param manager Pointer to the manager handling the search process.
+    /// @param modes The modes available for simulation.
+    /// @param parameters The search parameters.
+    /// @param seed The initial accepted solutions, which must be complete under
+    /// the given manager (see `seed_pareto_front`); pass it as an rvalue to avoid
+    /// copying them.
+    /// @param exchange Optional callback invoked with the accepted solutions after
+    /// each iteration (see `n_iterations`). A search exchanging its solutions is
+    /// never paused by the interactive mode, since it would stall the others.
+    ///
+    /// @return The result of the search containing the Pareto fronts.
+    template <typename State, typename Mode, typename Resources>
+    auto run(
+        const flexman::core::Manager<State, Mode, Resources> *manager,
+        const typename std::vector<Mode> &modes,
+        const SearchParameters &parameters,
+        flexman::core::ParetoFront<State, Resources> seed = {},
+        const std::function<void(std::vector<flexman::core::Solution<State, Resources>> &)> &exchange = {})
+        -> flexman::core::Result<State, Resources>
+    {
+        // Check for null pointer in manager.
+        if (manager == nullptr) {
+            throw std::invalid_argument("manager pointer is null.");
+        }
+
+        // Check if iterations is a valid number.
+        if (parameters.iterations == 0) {
+            throw std::invalid_argument("iterations must be greater than 0.");
+        }
+
+        // Get the number of iterations.
+        const unsigned iterations = parameters.iterations;
+
+        // Prepare the result.
+        flexman::core::Result<State, Resources> result;
+
+        // We store the pareto front here, starting from the seed.
+        flexman::core::ParetoFront<State, Resources> pareto_front = std::move(seed);
+
+        // A stopwatch, to check runtime.
+        timelib::Timer global_timer;
+
+        // Set the timeout.
+        if (manager->timeout) {
+            global_timer.set_timeout(manager->timeout);
+        }
+
+        // Start the timer.
+        global_timer.start();
+
+        // Calculate the maximum starting stride factor based on the number of iterations.
+        unsigned init_stride = 0;
+        if constexpr (!extension_policy::switches) {
+            init_stride = 1U;
+        }
+        // Start with the highest power of 2.
+        else {
+            init_stride = 1U << (iterations - 1);
+        }
+
+        qinfo(logging::search, "\n");
+        qinfo(logging::search, "| Max Iterations | Steps Per Iteration | Time Delta |\n");
+        qinfo(logging::search, "|----------------|---------------------|------------|\n");
+        for (unsigned steps_per_iteration = init_stride; steps_per_iteration >= 1; steps_per_iteration /= 2) {
+            // Calculate the time covered in each iteration.
+            const double time_per_iteration = manager->time_delta * static_cast<double>(steps_per_iteration);
+            // Determine the maximum number of steps allowed.
+            const auto max_iterations       = static_cast<unsigned>(manager->time_max / time_per_iteration);
+            qinfo(
+                logging::search, "| %14u | %19u | %10.6f |\n", max_iterations, steps_per_iteration,
+                time_per_iteration);
+        }
+        qinfo(logging::search, "\n");
+
+        // Can disable interactive mode.
+        bool disable_interactive = static_cast<bool>(exchange);
+
+        // The convergence criterion relies on the hypervolume, whose reference
+        // point is fixed from the first front.
+        bool check_convergence = parameters.convergence_tolerance > 0.0;
+        if constexpr (!EnergyTimeResources<Resources>) {
+            if (check_convergence) {
+                qwarning(logging::search, "The convergence criterion requires resources with energy and time.\n");
+                check_convergence = false;
+            }
+        }
+        std::optional<ReferencePoint> reference;
+        std::optional<double> previous_hypervolume;
+
+        for (unsigned steps_per_iteration = init_stride; steps_per_iteration >= 1; steps_per_iteration /= 2) {
+            // Perform a single-pass search.
+            pareto_front = this->n_iterations(
+                manager, modes, steps_per_iteration, std::move(pareto_front), global_timer, parameters, exchange);
+
+            // Measure the quality of the front.
+            if constexpr (EnergyTimeResources<Resources>) {
+                if (!pareto_front.solutions.empty()) {
+                    if (!reference) {
+                        reference = flexman::search::reference_point(pareto_front.solutions);
+                    }
+                    pareto_front.hypervolume = flexman::search::hypervolume(pareto_front.solutions, *reference);
+                }
+            }
+
+            // Add the pareto front only if it has solutions. This is the only
+            // copy of the front per stride, the next stride starts from it.
+            if (!pareto_front.solutions.empty()) {
+                pareto_front.runtime = global_timer.elapsed().count();
+                result.pareto_fronts.emplace_back(pareto_front);
+            }
+
+            // Check if the front stopped improving since the previous stride.
+            if (check_convergence && !pareto_front.solutions.empty() && (steps_per_iteration > 1)) {
+                if (previous_hypervolume && (*previous_hypervolume > 0.0)) {
+                    const double improvement =
+                        (pareto_front.hypervolume - *previous_hypervolume) / *previous_hypervolume;
+                    if (improvement < parameters.convergence_tolerance) {
+                        result.stop_reason = flexman::core::StopReason::Converged;
+                        if (parameters.convergence_action == ConvergenceAction::Stop) {
+                            qinfo(
+                                logging::search,
+                                "Stopping at stride factor %3u, the hypervolume improved by %.4f%% only.\n",
+                                steps_per_iteration, improvement * 100.0);
+                            break;
+                        }
+                        qinfo(
+                            logging::search,
+                            "Skipping to the finest stride after stride factor %3u, the hypervolume improved by %.4f%% "
+                            "only.\n",
+                            steps_per_iteration, improvement * 100.0);
+                        // The loop halves the stride, so that the next one is the finest.
+                        steps_per_iteration = 2;
+                        check_convergence   = false;
+                    }
+                }
+                previous_hypervolume = pareto_front.hypervolume;
+            }
+
+            // If we are in interactive mode, pause the search.
+            if (!disable_interactive && manager->interactive) {
+                // Pause the timer.
+                global_timer.pause();
+
+                qwarning(
+                    logging::search,
+                    "Press 'c' to continue the search, 'r' resume and disable interactive, 'q' to stop it now.\n");
+
+                do {
+                    char c = flexman::search::wait_for_keypress();
+                    if (c == 'c') {
+                    } else if (c == 'r') {
+                        disable_interactive = true;
+                    } else if (c == 'q') {
+                        steps_per_iteration = 0;
+                        result.stop_reason  = flexman::core::StopReason::UserStop;
+                    } else {
+                        continue;
+                    }
+                    break;
+                } while (true);
+
+                // Resume the timer.
+                global_timer.start();
+            }
+
+            // Stop if we went into timeout.
+            if (global_timer.has_timeout()) {
+                qwarning(logging::search, "Stopping at stride factor %3u, because of time-out.\n", steps_per_iteration);
+                result.stop_reason = flexman::core::StopReason::Timeout;
+                break;
+            }
+
+            // Stop if the checkpoint stopped the iterations.
+            if (cancelled) {
+                qwarning(
+                    logging::search, "Stopping at stride factor %3u, because of the checkpoint.\n",
+                    steps_per_iteration);
+                result.stop_reason = flexman::core::StopReason::Cancelled;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    /// @brief Checks if the checkpoint stopped the last call of `n_iterations`.
+    ///
+    /// @return True if the iterations were cancelled, false otherwise.
+    auto was_cancelled() const noexcept -> bool
+    {
+        return cancelled;
+    }
+
+private:
+    /// @brief Runs the extensions.
+    execution_policy execution;
+    /// @brief True if the checkpoint stopped the last call of `n_iterations`.
+    bool cancelled{false};
+};
+
+/// @brief The engine of a search algorithm.
+///
+/// @tparam Algorithm The search algorithm.
+template <SearchAlgorithm Algorithm>
+struct SearchPreset;
+
+/// @brief The exhaustive search: free switching, and no filter among the
+/// partial solutions.
+template <>
+struct SearchPreset<SearchAlgorithm::Exhaustive> {
+    /// @brief The engine.
+    using type = Search<policy::FreeSwitching, policy::KeepPartials>;
+};
+
+/// @brief The heuristic search: free switching, and the partial solutions
+/// probably dominated by another one are discarded.
+template <>
+struct SearchPreset<SearchAlgorithm::Heuristic> {
+    /// @brief The engine.
+    using type = Search<policy::FreeSwitching, policy::HeuristicFilter>;
+};
+
+/// @brief The single-machine search: no switching.
+template <>
+struct SearchPreset<SearchAlgorithm::SingleMachine> {
+    /// @brief The engine.
+    using type = Search<policy::NoSwitching, policy::KeepPartials>;
+};
+
+/// @brief The engine of a search algorithm.
+///
+/// @tparam Algorithm The search algorithm.
+template <SearchAlgorithm Algorithm>
+using preset_search_t = typename SearchPreset<Algorithm>::type;
+
+/// @brief Performs a single iteration of the search process, with the engine
+/// of the given algorithm (see `Search::single_iteration`).
 ///
 /// @tparam Algorithm The search algorithm to use.
 /// @tparam State The type representing the state.
 /// @tparam Mode The type representing the mode.
 /// @tparam Resources The type representing the resources.
+/// @tparam Partials The type of the partial solutions, a vector or a `PartialStore`.
 ///
 /// @param manager Pointer to the manager handling the search process.
 /// @param modes The set of modes available for simulation.
 /// @param steps_per_iteration The number of steps simulated in this iteration.
-/// @param partial_solutions The set of partial solutions to extend.
+/// @param partial_solutions The partial solutions to extend.
 /// @param accepted_solutions The set of accepted solutions (Pareto front).
 /// @param global_timer The global timer to track the search process duration.
-template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+/// @param cost_model Optional model of the remaining cost, used to prune and
+/// order the partial solutions.
+/// @param counters Optional hardware counters, where the phases are measured.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources, typename Partials>
 void perform_search_single_iteration(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const std::vector<Mode> &modes,
     const unsigned steps_per_iteration,
-    std::vector<flexman::core::Solution<State, Resources>> &partial_solutions,
+    Partials &partial_solutions,
     std::vector<flexman::core::Solution<State, Resources>> &accepted_solutions,
-    const timelib::Timer &global_timer)
+    const timelib::Timer &global_timer,
+    const CostModel *cost_model = nullptr,
+    SearchCounters *counters    = nullptr)
 {
-    // Check if manager is a valid pointer.
-    if (!manager) {
-        throw std::invalid_argument("manager pointer is null");
-    }
-
-    // Check if steps_per_iteration is a positive number.
-    if (steps_per_iteration == 0) {
-        throw std::invalid_argument("steps_per_iteration must be greater than 0");
-    }
-
-    // Check if modes vector is not empty.
-    if (modes.empty()) {
-        throw std::invalid_argument("modes vector is empty");
-    }
-
-    std::vector<flexman::core::Solution<State, Resources>> complete;
-    std::vector<flexman::core::Solution<State, Resources>> partial;
-    std::vector<flexman::core::Solution<State, Resources>> extended;
-
-    // First, we need t extend the partial solutions we have.
-    if (Algorithm == SearchAlgorithm::SingleMachine) {
-        extended =
-            extend_solutions<SwitchingMode::None>(manager, modes, steps_per_iteration, partial_solutions, global_timer);
-    } else {
-        extended =
-            extend_solutions<SwitchingMode::Free>(manager, modes, steps_per_iteration, partial_solutions, global_timer);
-    }
-    flexman::search::log_solutions(logging::solution, quire::debug, extended);
-
-    // Remove the dominated solutions from the Pareto front.
-    flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, extended, accepted_solutions);
-    flexman::search::log_solutions(logging::solution, quire::debug, extended);
-
-    // We split between complete solutions and partial ones.
-    flexman::search::split_complete_partial(manager, extended, complete, partial);
-
-    // We need to save complete solutions.
-    if (!complete.empty()) {
-        // Move solutions from `complete` to `accepted_solutions`.
-        flexman::search::move_elements(complete, accepted_solutions);
-        // Remove dominated solutions.
-        flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, accepted_solutions);
-        // Then we need to remove duplicate solutions.
-        flexman::search::remove_duplicate_solutions(accepted_solutions);
-    }
-
-    // Apply heuristic.
-    if constexpr (Algorithm == SearchAlgorithm::Heuristic) {
-        // Copy the list of partial solutions.
-        partial_solutions = partial;
-        flexman::search::remove_dominated_solutions<SearchAlgorithm::Heuristic>(manager, partial_solutions, partial);
-    } else {
-        // Update the list of partial solutions.
-        partial_solutions = std::move(partial);
-    }
+    preset_search_t<Algorithm> engine;
+    engine.single_iteration(
+        manager, modes, steps_per_iteration, partial_solutions, accepted_solutions, global_timer, cost_model, counters);
 }
 
-/// @brief Performs multiple iterations of the search process.
+/// @brief Performs multiple iterations of the search process, with the engine
+/// of the given algorithm (see `Search::n_iterations`).
 ///
 /// @tparam Algorithm The search algorithm to use.
 /// @tparam State The type representing the state.
@@ -136,8 +803,13 @@ void perform_search_single_iteration(
 /// @param manager Pointer to the manager handling the search process.
 /// @param modes The set of modes available for simulation.
 /// @param steps_per_iteration The number of steps simulated per iteration.
-/// @param previous_pareto_front The previous Pareto front of solutions.
+/// @param previous_pareto_front The previous Pareto front of solutions, whose
+/// solutions are moved into the returned front; pass it as an rvalue to avoid
+/// copying them.
 /// @param global_timer The global timer to track the search process duration.
+/// @param parameters The search parameters.
+/// @param exchange Optional callback invoked with the accepted solutions after
+/// each iteration, which can be used to share them with other searches.
 ///
 /// @return The updated Pareto front after performing the iterations.
 template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
@@ -145,110 +817,41 @@ auto perform_search_n_iterations(
     const flexman::core::Manager<State, Mode, Resources> *manager,
     const std::vector<Mode> &modes,
     const unsigned steps_per_iteration,
-    const flexman::core::ParetoFront<State, Resources> &previous_pareto_front,
-    const timelib::Timer &global_timer)
+    flexman::core::ParetoFront<State, Resources> previous_pareto_front,
+    const timelib::Timer &global_timer,
+    const SearchParameters &parameters = SearchParameters(),
+    const std::function<void(std::vector<flexman::core::Solution<State, Resources>> &)> &exchange = {})
 {
-    // Check if manager is a valid pointer.
-    if (!manager) {
-        throw std::invalid_argument("manager pointer is null");
-    }
-
-    // Check if steps_per_iteration is a positive number.
-    if (steps_per_iteration == 0) {
-        throw std::invalid_argument("steps_per_iteration must be greater than 0");
-    }
-
-    // Check if total_iterations is a positive number.
-    if (steps_per_iteration == 0) {
-        throw std::invalid_argument("total_iterations must be greater than 0");
-    }
-
-    // Check if modes vector is not empty.
-    if (modes.empty()) {
-        throw std::invalid_argument("modes vector is empty");
-    }
-
-    // Prepare the initial partial solutions.
-    std::vector<flexman::core::Solution<State, Resources>> partial_solutions;
-    // Iterate over the modes.
-    for (const auto &mode : modes) {
-        partial_solutions.push_back(
-            // Initial solution.
-            flexman::core::Solution<State, Resources>{
-                .sequence  = {{mode.id, 0}},                     // Empty sequence initially.
-                .state     = manager->initial_state,             // Start from the initial state.
-                .resources = Resources(),                        // Initialize resources.
-                .distance  = std::numeric_limits<double>::max(), // Initialize the distance to maximum.
-            });
-    }
-
-    // Prepare the accepted solutions from the previous Pareto front.
-    std::vector<flexman::core::Solution<State, Resources>> accepted_solutions = previous_pareto_front.solutions;
-
-    // A stopwatch to check runtime.
-    timelib::Timer pareto_timer;
-    timelib::Timer round_timer;
-
-    // Start the pareto timer.
-    pareto_timer.start();
-
-    // Calculate the time covered in each iteration.
-    const double time_per_iteration = manager->time_delta * static_cast<double>(steps_per_iteration);
-
-    // Determine the maximum number of steps allowed.
-    const auto max_iterations = static_cast<unsigned>(manager->time_max / time_per_iteration);
-
-    qinfo(
-        logging::round, "\nPerform %6u iterations maximum, with %5u steps per iteration, each simulating %7.2f.\n",
-        max_iterations, steps_per_iteration, time_per_iteration);
-
-    // Perform the search for the specified number of steps or until no partial solutions remain.
-    unsigned iteration = 0;
-    while ((iteration < max_iterations) && !partial_solutions.empty()) {
-        // Start the round timer.
-        round_timer.start();
-
-        // Perform a single iteration of the search process.
-        flexman::search::perform_search_single_iteration<Algorithm>(
-            manager, modes, steps_per_iteration, partial_solutions, accepted_solutions, global_timer);
-
-        ++iteration;
-
-        qinfo(logging::round, "Step: %6d/%-6d, ", iteration, max_iterations);
-        qinfo(logging::round, "Part: %6d, ", partial_solutions.size());
-        qinfo(logging::round, "Full: %6d, ", accepted_solutions.size());
-        qinfo(logging::round, "RndTm: %8.3f s, ", round_timer.elapsed().count());
-        qinfo(logging::round, "RunTm: %8.3f s , ", global_timer.elapsed().count());
-        qinfo(logging::round, "RemTm: %8.3f s\r", global_timer.remaining().count());
-        if ((iteration == max_iterations) || partial_solutions.empty()) {
-            qinfo(logging::round, "\n");
-        }
-
-        qdebug(logging::solution, "Accepted solutions:\n");
-        flexman::search::log_solutions(logging::solution, quire::debug, accepted_solutions);
-        qdebug(logging::solution, "Partial solutions:\n");
-        flexman::search::log_solutions(logging::solution, quire::debug, partial_solutions);
-
-        if (global_timer.has_timeout()) {
-            qwarning(
-                logging::round,
-                "Iteration index %2u of %3u (Steps: %d, Length: %.2f), went into timeout (%.2f > %.2f).\n", iteration,
-                max_iterations, steps_per_iteration, time_per_iteration, global_timer.elapsed().count(),
-                manager->timeout.count());
-            break;
-        }
-    }
-
-    auto new_pareto_front = flexman::core::ParetoFront<State, Resources>{
-        .solutions           = accepted_solutions,            // The final set of accepted solutions.
-        .step_length         = time_per_iteration,            // The length of each iteration.
-        .steps_per_iteration = steps_per_iteration,           // The number of steps per iteration.
-        .iteration           = iteration,                     // The total number of iterations performed.
-        .runtime             = pareto_timer.elapsed().count() // The runtime of the search process.
-    };
+    preset_search_t<Algorithm> engine;
+    return engine.n_iterations(
+        manager, modes, steps_per_iteration, std::move(previous_pareto_front), global_timer, parameters, exchange);
+}
 
-    // Return the updated Pareto front after performing the iterations.
-    return new_pareto_front;
+/// @brief Performs a search using the given parameters and modes, starting
+/// from a seed Pareto front, with the engine of the given algorithm (see
+/// `Search::run`).
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param parameters The search parameters.
+/// @param seed The initial accepted solutions, which must be complete under
+/// the given manager (see `seed_pareto_front`); pass it as an rvalue to avoid
+/// copying them.
+///
+/// @return The result of the search containing the Pareto fronts.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+auto perform_search(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const typename std::vector<Mode> &modes,
+    const SearchParameters &parameters,
+    flexman::core::ParetoFront<State, Resources> seed)
+{
+    preset_search_t<Algorithm> engine;
+    return engine.run(manager, modes, parameters, std::move(seed));
 }
 
 /// @brief Performs a search using the given parameters and modes.
@@ -259,6 +862,27 @@ auto perform_search_n_iterations(
 ///
 /// @param manager Pointer to the manager handling the search process.
 /// @param modes The modes available for simulation.
+/// @param parameters The search parameters.
+///
+/// @return The result of the search containing the Pareto fronts.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+auto perform_search(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const typename std::vector<Mode> &modes,
+    const SearchParameters &parameters)
+{
+    return flexman::search::perform_search<Algorithm>(
+        manager, modes, parameters, flexman::core::ParetoFront<State, Resources>{});
+}
+
+/// @brief Performs a search using the given number of iterations and modes.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
 /// @param iterations The number of iterations to perform in the search.
 ///
 /// @return The result of the search containing the Pareto fronts.
@@ -268,103 +892,9 @@ auto perform_search(
     const typename std::vector<Mode> &modes,
     unsigned iterations = 5)
 {
-    // Check for null pointer in manager.
-    if (manager == nullptr) {
-        throw std::invalid_argument("manager pointer is null.");
-    }
-
-    // Check if iterations is a valid number.
-    if (iterations == 0) {
-        throw std::invalid_argument("iterations must be greater than 0.");
-    }
-
-    // Prepare the result.
-    flexman::core::Result<State, Resources> result;
-
-    // We store the pareto front here.
-    flexman::core::ParetoFront<State, Resources> pareto_front;
-
-    // A stopwatch, to check runtime.
-    timelib::Timer global_timer;
-
-    // Set the timeout.
-    if (manager->timeout) {
-        global_timer.set_timeout(manager->timeout);
-    }
-
-    // Start the timer.
-    global_timer.start();
-
-    // Calculate the maximum starting stride factor based on the number of iterations.
-    unsigned init_stride = 0;
-    if constexpr (Algorithm == SearchAlgorithm::SingleMachine) {
-        init_stride = 1U;
-    }
-    // Start with the highest power of 2.
-    else {
-        init_stride = 1U << (iterations - 1);
-    }
-
-    qinfo(logging::search, "\n");
-    qinfo(logging::search, "| Max Iterations | Steps Per Iteration | Time Delta |\n");
-    qinfo(logging::search, "|----------------|---------------------|------------|\n");
-    for (unsigned steps_per_iteration = init_stride; steps_per_iteration >= 1; steps_per_iteration /= 2) {
-        // Calculate the time covered in each iteration.
-        const double time_per_iteration = manager->time_delta * static_cast<double>(steps_per_iteration);
-        // Determine the maximum number of steps allowed.
-        const auto max_iterations       = static_cast<unsigned>(manager->time_max / time_per_iteration);
-        qinfo(logging::search, "| %14u | %19u | %10.6f |\n", max_iterations, steps_per_iteration, time_per_iteration);
-    }
-    qinfo(logging::search, "\n");
-
-    // Can disable interactive mode.
-    bool disable_interactive = false;
-
-    for (unsigned steps_per_iteration = init_stride; steps_per_iteration >= 1; steps_per_iteration /= 2) {
-        // Perform a single-pass search.
-        pareto_front = flexman::search::perform_search_n_iterations<Algorithm>(
-            manager, modes, steps_per_iteration, pareto_front, global_timer);
-
-        // Add the pareto front only if it has solutions.
-        if (!pareto_front.solutions.empty()) {
-            pareto_front.runtime = global_timer.elapsed().count();
-            result.pareto_fronts.emplace_back(pareto_front);
-        }
-
-        // If we are in interactive mode, pause the search.
-        if (!disable_interactive && manager->interactive) {
-            // Pause the timer.
-            global_timer.pause();
-
-            qwarning(
-                logging::search,
-                "Press 'c' to continue the search, 'r' resume and disable interactive, 'q' to stop it now.\n");
-
-            do {
-                char c = flexman::search::wait_for_keypress();
-                if (c == 'c') {
-                } else if (c == 'r') {
-                    disable_interactive = true;
-                } else if (c == 'q') {
-                    steps_per_iteration = 0;
-                } else {
-                    continue;
-                }
-                break;
-            } while (true);
-
-            // Resume the timer.
-            global_timer.start();
-        }
-
-        // Stop if we went into timeout.
-        if (global_timer.has_timeout()) {
-            qwarning(logging::search, "Stopping at stride factor %3u, because of time-out.\n", steps_per_iteration);
-            break;
-        }
-    }
-
-    return result;
+    SearchParameters parameters;
+    parameters.iterations = iterations;
+    return flexman::search::perform_search<Algorithm>(manager, modes, parameters);
 }
 
 } // namespace search
@@ -0,0 +1,191 @@
+/// @file seed.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the seeding of a search with a prior Pareto front.
+///
+/// @details
+/// When a search differs only slightly from an earlier one (e.g., a different
+/// target or threshold), the solutions found by the earlier search are good
+/// candidates for the new one. This file provides:
+/// - The `adapt_solution` function, which re-simulates the sequence of a prior
+///   solution under a new manager, stopping as soon as it completes, or
+///   extending its last mode if it does not complete anymore.
+/// - The `seed_pareto_front` function, which adapts all the solutions of a
+///   prior result, and keeps the non-dominated ones.
+///
+/// The resulting front can be passed to `perform_search` as its initial set of
+/// accepted solutions, so that dominance pruning is effective from the first
+/// iteration.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/mode_execution.hpp"
+#include "flexman/core/result.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief Re-simulates the sequence of a prior solution under a new manager.
+///
+/// @details The sequence is simulated from the initial state of the manager,
+/// and it is cut as soon as the solution completes. If the sequence ends before
+/// completing, its last mode is executed until the solution completes, or until
+/// the maximum simulated time of the manager is reached.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager of the new search.
+/// @param modes The modes available in the new search, indexed by their id.
+/// @param sequence The sequence of the prior solution.
+///
+/// @return The adapted solution, or nothing if it cannot be completed.
+template <typename State, typename Mode, typename Resources>
+auto adapt_solution(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const std::vector<flexman::core::ModeExecution> &sequence)
+    -> std::optional<flexman::core::Solution<State, Resources>>
+{
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+
+    // The sequence must only use the modes of the new search.
+    if (sequence.empty()) {
+        return std::nullopt;
+    }
+    for (const auto &execution : sequence) {
+        if (execution.mode >= modes.size()) {
+            return std::nullopt;
+        }
+    }
+
+    flexman::core::Solution<State, Resources> solution{
+        .sequence  = {},
+        .state     = manager->initial_state,
+        .resources = Resources(),
+        .distance  = std::numeric_limits<double>::max(),
+    };
+
+    // The maximum number of steps we are allowed to simulate.
+    const auto max_steps = static_cast<std::size_t>(manager->time_max / manager->time_delta);
+
+    std::size_t steps = 0;
+
+    // Simulates a single step, and interpolates the overshoot upon completion.
+    auto step = [&](flexman::core::ModeId mode) {
+        auto previous = solution;
+        manager->updated_solution(solution, modes[mode]);
+        flexman::core::detail::add_mode_execution_to_sequence(mode, solution.sequence);
+        ++steps;
+        if (manager->is_complete(solution)) {
+            solution = flexman::search::find_solution_closest_to_zero(manager, previous, solution);
+            return true;
+        }
+        return false;
+    };
+
+    // Replay the prior sequence, until the solution completes.
+    for (const auto &execution : sequence) {
+        for (std::size_t i = 0; i < execution.times; ++i) {
+            if (step(execution.mode)) {
+                return solution;
+            }
+        }
+    }
+
+    // Extend the last mode, until the solution completes.
+    while (steps < max_steps) {
+        if (step(sequence.back().mode)) {
+            return solution;
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief Builds an initial Pareto front from the solutions of a prior result.
+///
+/// @details All the solutions of all the fronts of the prior result are adapted
+/// to the new manager; the ones that complete are filtered for dominance and
+/// duplicates.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager of the new search.
+/// @param modes The modes available in the new search, indexed by their id.
+/// @param prior The result of the prior search.
+///
+/// @return The seed Pareto front.
+template <typename State, typename Mode, typename Resources>
+auto seed_pareto_front(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const flexman::core::Result<State, Resources> &prior) -> flexman::core::ParetoFront<State, Resources>
+{
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+
+    timelib::Timer timer;
+    timer.start();
+
+    flexman::core::ParetoFront<State, Resources> seed{
+        .solutions           = {},
+        .step_length         = 0.0,
+        .steps_per_iteration = 0,
+        .iteration           = 0,
+        .runtime             = 0.0,
+        .hypervolume         = 0.0,
+    };
+
+    // Adapt the prior solutions.
+    std::size_t total = 0;
+    for (const auto &pareto_front : prior.pareto_fronts) {
+        for (const auto &solution : pareto_front.solutions) {
+            ++total;
+            if (auto adapted = flexman::search::adapt_solution(manager, modes, solution.sequence)) {
+                seed.solutions.emplace_back(std::move(*adapted));
+            }
+        }
+    }
+    const std::size_t complete = seed.solutions.size();
+
+    // Keep the non-dominated ones.
+    flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, seed.solutions);
+    flexman::search::remove_duplicate_solutions(seed.solutions);
+
+    seed.runtime = timer.elapsed().count();
+
+    qinfo(
+        logging::search, "Seeded %u solutions from %u prior ones (%u completed under the new manager).\n",
+        seed.solutions.size(), total, complete);
+
+    return seed;
+}
+
+} // namespace search
+} // namespace flexman
@@ -0,0 +1,727 @@
+/// @file sharded.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements a multi-process search, sharded over the initial modes.
+///
+/// @details
+/// This file provides the `perform_sharded_search` function, which splits the
+/// first-level branches of the search (i.e., the mode each solution starts
+/// from) across local worker processes. Each worker runs `Search::run` on its
+/// own shard, and the workers cooperate through a
+/// `SharedArchive`: a POSIX shared-memory region where each worker publishes
+/// its complete solutions, and from which it imports the ones published by the
+/// others to prune its own partial solutions. At the end, the fronts of each
+/// stride are merged by the parent process.
+///
+/// Running the shards in separate processes gives each of them its own address
+/// space, so that a worker running out of memory, or crashing, does not take
+/// down the others. Its front is lost, though: the solutions it published have
+/// already pruned the other shards, which do not return them, hence, the
+/// merged front misses the part of the front found by that worker. The workers
+/// are forked, so the search must start before the process runs any other
+/// thread. The sharded search is only available on POSIX systems; elsewhere it
+/// falls back to the single-process search.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "flexman/async_logging.hpp"
+#include "flexman/core/result.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+#include "flexman/search/metrics.hpp"
+#include "flexman/search/partial_store.hpp"
+#include "flexman/search/search.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief Structure to define the parameters of the sharded search.
+struct ShardParameters {
+    /// @brief Number of worker processes, zero uses the hardware concurrency.
+    unsigned workers             = 0;
+    /// @brief Maximum number of solutions the shared archive can hold.
+    std::size_t archive_capacity = 1U << 16U;
+};
+
+#ifndef _WIN32
+
+/// @brief A Pareto archive in POSIX shared memory, shared by the workers of a
+/// sharded search.
+///
+/// @details The archive is an append-only array of fixed-size records. Workers
+/// reserve a slot with an atomic increment, fill it, and then mark it as ready,
+/// hence, publishing never blocks. Only the state, the resources and the
+/// distance of a solution are stored, which is all that is needed to prune
+/// other solutions. The archive must be created before forking the workers,
+/// which inherit the mapping.
+///
+/// @tparam State The type representing the system's state.
+/// @tparam Resources The type representing the system's resources.
+template <typename State, typename Resources>
+class SharedArchive
+{
+public:
+    /// @brief The type of the solutions stored in the archive.
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    /// @brief The mode of the sequence of the imported solutions, which is not
+    /// the identifier of any mode.
+    static constexpr flexman::core::ModeId imported_mode = std::numeric_limits<flexman::core::ModeId>::max();
+
+    static_assert(
+        std::is_trivially_copyable_v<State> && std::is_trivially_copyable_v<Resources>,
+        "the shared archive requires trivially copyable states and resources");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the shared archive requires lock-free atomics");
+
+    /// @brief Creates the archive.
+    ///
+    /// @param capacity the maximum number of solutions the archive can hold.
+    explicit SharedArchive(std::size_t capacity)
+        : slots(capacity)
+    {
+        if (slots == 0) {
+            throw std::invalid_argument("archive capacity must be greater than 0");
+        }
+        // Place the records after the header, properly aligned.
+        offset = ((sizeof(header_t) + alignof(record_t) - 1) / alignof(record_t)) * alignof(record_t);
+        length = offset + slots * sizeof(record_t);
+
+        // Create a uniquely named shared memory object.
+        static std::atomic<unsigned> counter{0};
+        const std::string name = "/flexman-archive-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+        int fd                 = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            throw std::runtime_error("failed to create the shared archive " + name);
+        }
+        // The mapping outlives the name, so we can unlink it right away and
+        // nothing is left behind if a process crashes.
+        ::shm_unlink(name.c_str());
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("failed to size the shared archive " + name);
+        }
+        region = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (region == MAP_FAILED) {
+            region = nullptr;
+            throw std::runtime_error("failed to map the shared archive " + name);
+        }
+        auto *bytes = static_cast<unsigned char *>(region);
+        header      = new (bytes) header_t{};
+        records     = reinterpret_cast<record_t *>(bytes + offset);
+        for (std::size_t i = 0; i < slots; ++i) {
+            new (&records[i]) record_t{};
+        }
+    }
+
+    /// @brief Copy constructor (deleted, the mapping is owned by a single archive).
+    SharedArchive(const SharedArchive &other) = delete;
+
+    /// @brief Copy assignment operator (deleted, the mapping is owned by a single archive).
+    auto operator=(const SharedArchive &other) -> SharedArchive & = delete;
+
+    /// @brief Move constructor (deleted, workers refer to the archive by address).
+    SharedArchive(SharedArchive &&other) = delete;
+
+    /// @brief Move assignment operator (deleted, workers refer to the archive by address).
+    auto operator=(SharedArchive &&other) -> SharedArchive & = delete;
+
+    /// @brief Destructor, unmaps the shared memory.
+    ~SharedArchive()
+    {
+        if (region) {
+            ::munmap(region, length);
+        }
+    }
+
+    /// @brief Returns the maximum number of solutions the archive can hold.
+    /// @return the capacity of the archive.
+    auto capacity() const noexcept -> std::size_t { return slots; }
+
+    /// @brief Returns the number of reserved slots.
+    /// @return the number of solutions published, or being published.
+    auto size() const noexcept -> std::size_t
+    {
+        return std::min<std::size_t>(header->count.load(std::memory_order_acquire), slots);
+    }
+
+    /// @brief Publishes a solution.
+    ///
+    /// @param solution the solution to publish.
+    /// @param origin the identifier of the publishing worker.
+    ///
+    /// @return true if the solution was published, false if the archive is full.
+    auto publish(const solution_t &solution, std::uint32_t origin) noexcept -> bool
+    {
+        const auto index = header->count.fetch_add(1, std::memory_order_relaxed);
+        if (index >= slots) {
+            return false;
+        }
+        record_t &record = records[index];
+        record.origin    = origin;
+        record.distance  = solution.distance;
+        record.state     = solution.state;
+        record.resources = solution.resources;
+        record.ready.store(1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Checks if a solution was imported from the archive.
+    ///
+    /// @param solution the solution.
+    ///
+    /// @return true if the solution was imported, false if it was found by this worker.
+    static auto is_imported(const solution_t &solution) noexcept -> bool
+    {
+        return !solution.sequence.empty() && (solution.sequence.front().mode == imported_mode);
+    }
+
+    /// @brief Imports the solutions published by the other workers.
+    ///
+    /// @details Only the state and the resources of a solution are shared,
+    /// hence, the sequence of an imported solution is a single execution of
+    /// `imported_mode`, repeated as many times as the index of its slot. The
+    /// sequences are distinct, so that the imported solutions are not taken
+    /// for duplicates of each other when the front is sorted and deduplicated.
+    /// Reading stops at the first slot that is still being written, and
+    /// `cursor` is left there for the next call.
+    ///
+    /// @param cursor the index of the first slot to read, advanced past the
+    /// slots that have been read.
+    /// @param origin the identifier of the importing worker, whose own
+    /// solutions are skipped.
+    /// @param solutions the vector where the imported solutions are appended.
+    ///
+    /// @return the number of imported solutions.
+    auto import(std::size_t &cursor, std::uint32_t origin, std::vector<solution_t> &solutions) const -> std::size_t
+    {
+        std::size_t imported = 0;
+        const std::size_t end = this->size();
+        for (; cursor < end; ++cursor) {
+            const record_t &record = records[cursor];
+            if (record.ready.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+            if (record.origin == origin) {
+                continue;
+            }
+            solutions.emplace_back(solution_t{
+                .sequence  = {{imported_mode, cursor}},
+                .state     = record.state,
+                .resources = record.resources,
+                .distance  = record.distance,
+            });
+            ++imported;
+        }
+        return imported;
+    }
+
+    /// @brief Counts the solutions published by a worker.
+    ///
+    /// @param origin the identifier of the worker.
+    ///
+    /// @return the number of solutions the worker published completely.
+    auto published_by(std::uint32_t origin) const noexcept -> std::size_t
+    {
+        std::size_t count     = 0;
+        const std::size_t end = this->size();
+        for (std::size_t index = 0; index < end; ++index) {
+            if ((records[index].ready.load(std::memory_order_acquire) != 0) && (records[index].origin == origin)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    /// @brief The header of the shared region.
+    struct header_t {
+        /// @brief The number of reserved slots.
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    /// @brief A record of the shared region.
+    struct record_t {
+        /// @brief Set once the record has been completely written.
+        std::atomic<std::uint32_t> ready{0};
+        /// @brief The worker that published the record.
+        std::uint32_t origin{0};
+        /// @brief The distance of the solution.
+        double distance{0};
+        /// @brief The state of the solution.
+        State state{};
+        /// @brief The resources of the solution.
+        Resources resources{};
+    };
+
+    /// @brief The maximum number of records.
+    std::size_t slots;
+    /// @brief The offset of the records from the start of the region.
+    std::size_t offset{0};
+    /// @brief The size of the region.
+    std::size_t length{0};
+    /// @brief The shared memory region.
+    void *region{nullptr};
+    /// @brief The header, at the start of the region.
+    header_t *header{nullptr};
+    /// @brief The records, after the header.
+    record_t *records{nullptr};
+};
+
+namespace detail
+{
+
+/// @brief The header of a Pareto front written by a worker to its result file.
+struct shard_front_t {
+    double step_length;
+    std::uint32_t steps_per_iteration;
+    std::uint32_t iteration;
+    double runtime;
+    std::uint64_t count;
+};
+
+/// @brief Runs the search of a single shard, inside a worker process.
+///
+/// @details The shard runs `Search::run` of the engine of the algorithm, which
+/// exchanges its solutions with the other workers after each iteration. The
+/// result file starts with the reason the search stopped, followed by the
+/// fronts, without the imported solutions.
+///
+/// @tparam Algorithm The search algorithm to use.
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param parameters The search parameters, restricted to the shard.
+/// @param seed The initial accepted solutions.
+/// @param archive The archive shared with the other workers.
+/// @param origin The identifier of this worker.
+/// @param output The file where the Pareto fronts of this worker are written.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+void run_shard(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const SearchParameters &parameters,
+    const flexman::core::ParetoFront<State, Resources> &seed,
+    SharedArchive<State, Resources> &archive,
+    std::uint32_t origin,
+    const std::string &output)
+{
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    std::FILE *file = std::fopen(output.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("failed to open the shard result file " + output);
+    }
+
+    // The solutions we already published, and where we stopped importing.
+    std::vector<solution_t> published;
+    std::size_t cursor = 0;
+    bool full          = false;
+
+    // Publishes our new complete solutions and imports the ones of the others,
+    // which the front keeps, so that they keep pruning the next strides.
+    std::function<void(std::vector<solution_t> &)> exchange = [&](std::vector<solution_t> &accepted) {
+        for (const auto &solution : accepted) {
+            // Only publish our own solutions.
+            if (SharedArchive<State, Resources>::is_imported(solution)) {
+                continue;
+            }
+            if (std::any_of(published.begin(), published.end(), [&](const solution_t &other) {
+                    return other.sequence == solution.sequence;
+                })) {
+                continue;
+            }
+            if (!archive.publish(solution, origin)) {
+                if (!full) {
+                    qwarning(logging::search, "Shard %u: the shared archive is full.\n", origin);
+                    full = true;
+                }
+                break;
+            }
+            published.emplace_back(solution);
+        }
+        if (archive.import(cursor, origin, accepted) > 0) {
+            // An imported solution with the same resources of one of ours would
+            // be taken for its duplicate, and could replace it, while the worker
+            // that found it may have replaced its own copy with ours. Hence, we
+            // keep ours. A solution we find later can still be replaced by an
+            // equal import, but then the worker that published the import keeps
+            // its own copy, since it never imports one equal to its own.
+            std::vector<Resources> own;
+            for (const auto &solution : accepted) {
+                if (!SharedArchive<State, Resources>::is_imported(solution)) {
+                    own.emplace_back(solution.resources);
+                }
+            }
+            std::erase_if(accepted, [&own](const solution_t &solution) {
+                return SharedArchive<State, Resources>::is_imported(solution) &&
+                       std::any_of(own.begin(), own.end(), [&solution](const Resources &resources) {
+                           return resources == solution.resources;
+                       });
+            });
+            flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, accepted);
+            flexman::search::remove_duplicate_solutions(accepted);
+        }
+    };
+
+    try {
+        preset_search_t<Algorithm> engine;
+        const auto result = engine.run(manager, modes, parameters, seed, exchange);
+
+        detail::write_value(file, static_cast<std::uint32_t>(result.stop_reason));
+        for (const auto &pareto_front : result.pareto_fronts) {
+            // Write only our own solutions.
+            std::vector<const solution_t *> own;
+            for (const auto &solution : pareto_front.solutions) {
+                if (!SharedArchive<State, Resources>::is_imported(solution)) {
+                    own.emplace_back(&solution);
+                }
+            }
+            if (own.empty()) {
+                continue;
+            }
+            detail::write_value(
+                file, shard_front_t{
+                          .step_length         = pareto_front.step_length,
+                          .steps_per_iteration = pareto_front.steps_per_iteration,
+                          .iteration           = pareto_front.iteration,
+                          .runtime             = pareto_front.runtime,
+                          .count               = own.size(),
+                      });
+            for (const auto *solution : own) {
+                detail::write_solution(file, *solution);
+            }
+        }
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("failed to write the shard result file " + output);
+    }
+}
+
+/// @brief Reads the Pareto fronts written by a worker.
+///
+/// @tparam State The type representing the state.
+/// @tparam Resources The type representing the resources.
+///
+/// @param input The result file of the worker.
+/// @param fronts The fronts, indexed by their number of steps per iteration,
+/// where the read solutions are appended.
+///
+/// @return The reason the search of the worker stopped.
+template <typename State, typename Resources>
+auto read_shard(
+    const std::string &input,
+    std::map<unsigned, flexman::core::ParetoFront<State, Resources>, std::greater<>> &fronts)
+    -> flexman::core::StopReason
+{
+    std::ifstream stream(input, std::ios::binary);
+    const std::vector<unsigned char> content{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+    const unsigned char *data = content.data();
+    const unsigned char *end  = data + content.size();
+    std::uint32_t stop_reason = 0;
+    if (static_cast<std::size_t>(end - data) < sizeof(stop_reason)) {
+        throw std::runtime_error("the shard result file " + input + " is truncated");
+    }
+    detail::read_value(data, stop_reason);
+    shard_front_t header{};
+    while (static_cast<std::size_t>(end - data) >= sizeof(shard_front_t)) {
+        detail::read_value(data, header);
+        auto &front               = fronts[header.steps_per_iteration];
+        front.step_length         = header.step_length;
+        front.steps_per_iteration = header.steps_per_iteration;
+        front.iteration           = std::max(front.iteration, header.iteration);
+        front.runtime             = std::max(front.runtime, header.runtime);
+        for (std::uint64_t i = 0; i < header.count; ++i) {
+            flexman::core::Solution<State, Resources> solution;
+            detail::read_solution(data, solution);
+            front.solutions.emplace_back(std::move(solution));
+        }
+    }
+    return static_cast<flexman::core::StopReason>(stop_reason);
+}
+
+/// @brief Counts the threads of the calling process.
+///
+/// @return The number of threads, or zero if the platform does not tell.
+inline auto count_threads() -> std::size_t
+{
+    std::size_t threads = 0;
+#ifdef __linux__
+    std::error_code error;
+    for (std::filesystem::directory_iterator it("/proc/self/task", error), end; !error && (it != end);
+         it.increment(error)) {
+        ++threads;
+    }
+#endif
+    return threads;
+}
+
+} // namespace detail
+
+#endif
+
+/// @brief Performs a search sharded over the initial modes, across local
+/// worker processes.
+///
+/// @details Each worker starts the search from a subset of the modes (or from
+/// the subset of `parameters.initial_modes`, if given), and from the seed, and
+/// shares its complete solutions with the others through a `SharedArchive`.
+/// The result stops for the reason of the first worker that did not complete
+/// all its strides, or with `StopReason::Incomplete` if a worker failed.
+///
+/// A worker that fails is reported, and the result misses its front, as well
+/// as the solutions the other workers discarded because of it. The workers are
+/// forked from the calling thread, and they do not inherit the other threads
+/// of the process, e.g., the ones of a `PooledExecution` or a `JobScheduler`,
+/// hence, the search must be started before any of them: a lock held by
+/// another thread at the fork would never be released in the workers. For the
+/// same reason, the checkpoint of the parameters runs in the workers, and it
+/// must not wait for other threads. The asynchronous sink is stopped while
+/// forking, and the manager must not rely on other state that does not
+/// survive a `fork`.
+///
+/// @tparam Algorithm The search algorithm to use.
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The modes available for simulation.
+/// @param parameters The search parameters.
+/// @param sharding The sharding parameters.
+/// @param seed The initial accepted solutions, shared by all the workers, which
+/// must be complete under the given manager (see `seed_pareto_front`).
+///
+/// @return The result of the search containing the merged Pareto fronts.
+template <SearchAlgorithm Algorithm, typename State, typename Mode, typename Resources>
+auto perform_sharded_search(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const typename std::vector<Mode> &modes,
+    const SearchParameters &parameters,
+    const ShardParameters &sharding                   = ShardParameters(),
+    flexman::core::ParetoFront<State, Resources> seed = {})
+{
+    // Check for null pointer in manager.
+    if (manager == nullptr) {
+        throw std::invalid_argument("manager pointer is null.");
+    }
+
+    // Check if iterations is a valid number.
+    if (parameters.iterations == 0) {
+        throw std::invalid_argument("iterations must be greater than 0.");
+    }
+
+    // Check if modes vector is not empty.
+    if (modes.empty()) {
+        throw std::invalid_argument("modes vector is empty");
+    }
+
+#ifdef _WIN32
+    qwarning(logging::search, "Sharded search is not supported on this platform, running a single search.\n");
+    return flexman::search::perform_search<Algorithm>(manager, modes, parameters, std::move(seed));
+#else
+    // Collect the modes the search starts from.
+    std::vector<flexman::core::ModeId> roots;
+    for (const auto &mode : modes) {
+        if (parameters.initial_modes.empty() ||
+            std::find(parameters.initial_modes.begin(), parameters.initial_modes.end(), mode.id) !=
+                parameters.initial_modes.end()) {
+            roots.emplace_back(mode.id);
+        }
+    }
+    if (roots.empty()) {
+        throw std::invalid_argument("none of the initial modes is available");
+    }
+
+    // Determine the number of workers.
+    std::size_t workers = sharding.workers ? sharding.workers : std::max(1U, std::thread::hardware_concurrency());
+    workers             = std::min(workers, roots.size());
+
+    if (manager->interactive) {
+        qwarning(logging::search, "Interactive mode is disabled in a sharded search.\n");
+    }
+
+    // Assign the root modes to the workers, round-robin.
+    std::vector<SearchParameters> shards(workers, parameters);
+    for (auto &shard : shards) {
+        shard.initial_modes.clear();
+    }
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        shards[i % workers].initial_modes.emplace_back(roots[i]);
+    }
+
+    // Create the result files of the workers.
+    const std::filesystem::path directory = parameters.spill_directory.empty()
+                                                ? std::filesystem::temp_directory_path()
+                                                : std::filesystem::path(parameters.spill_directory);
+    std::vector<std::string> outputs;
+    for (std::size_t i = 0; i < workers; ++i) {
+        std::string name = (directory / "flexman-shard-XXXXXX").string();
+        int fd           = ::mkstemp(name.data());
+        if (fd < 0) {
+            for (const auto &output : outputs) {
+                std::filesystem::remove(output);
+            }
+            throw std::runtime_error("failed to create a shard result file in " + directory.string());
+        }
+        ::close(fd);
+        outputs.emplace_back(std::move(name));
+    }
+
+    SharedArchive<State, Resources> archive(sharding.archive_capacity);
+
+    qinfo(logging::search, "Sharding %u initial modes across %u workers.\n", roots.size(), workers);
+
+    // The workers would not inherit the flusher of the asynchronous sink,
+    // hence, we stop it while forking.
+    const bool async_logging = flexman::logging::async_sink().running();
+    flexman::logging::async_sink().stop();
+
+    // The workers only inherit the calling thread.
+    const std::size_t threads = detail::count_threads();
+    if (threads > 1) {
+        qwarning(
+            logging::search, "Forking the workers from a process running %u threads, which they do not inherit.\n",
+            threads);
+    }
+
+    // Flush the output streams, so that the workers do not replay them.
+    std::cout.flush();
+    std::fflush(nullptr);
+
+    // Fork the workers.
+    std::vector<pid_t> pids(workers, -1);
+    for (std::size_t i = 0; i < workers; ++i) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int status = 0;
+            try {
+                detail::run_shard<Algorithm>(
+                    manager, modes, shards[i], seed, archive, static_cast<std::uint32_t>(i), outputs[i]);
+            } catch (const std::exception &e) {
+                qerror(logging::search, "Shard %u failed: %s\n", i, e.what());
+                status = 1;
+            } catch (...) {
+                status = 1;
+            }
+            std::cout.flush();
+            std::fflush(nullptr);
+            ::_exit(status);
+        }
+        if (pid < 0) {
+            qerror(logging::search, "Failed to fork the worker of shard %u.\n", i);
+        }
+        pids[i] = pid;
+    }
+
+    if (async_logging) {
+        flexman::logging::async_sink().start();
+    }
+
+    // Wait for the workers, and collect the fronts of the successful ones.
+    flexman::core::Result<State, Resources> result;
+    std::map<unsigned, flexman::core::ParetoFront<State, Resources>, std::greater<>> fronts;
+    bool lost = false;
+    for (std::size_t i = 0; i < workers; ++i) {
+        if (pids[i] < 0) {
+            lost = true;
+        } else {
+            int status = 0;
+            while ((::waitpid(pids[i], &status, 0) < 0) && (errno == EINTR)) {
+            }
+            if (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) {
+                const auto stop_reason = detail::read_shard(outputs[i], fronts);
+                if (result.stop_reason == flexman::core::StopReason::Completed) {
+                    result.stop_reason = stop_reason;
+                }
+            } else {
+                // The solutions it published pruned the other shards, which do
+                // not return them, hence, the merged front is incomplete.
+                if (WIFSIGNALED(status)) {
+                    qwarning(
+                        logging::search, "Shard %u was terminated by signal %d, its front is lost.\n", i,
+                        WTERMSIG(status));
+                } else {
+                    qwarning(logging::search, "Shard %u failed, its front is lost.\n", i);
+                }
+                qwarning(
+                    logging::search,
+                    "The %u solutions it published pruned the other shards, the merged front is incomplete.\n",
+                    archive.published_by(static_cast<std::uint32_t>(i)));
+                lost = true;
+            }
+        }
+        std::filesystem::remove(outputs[i]);
+    }
+    if (lost) {
+        result.stop_reason = flexman::core::StopReason::Incomplete;
+    }
+
+    // Merge the fronts of each stride.
+    std::optional<ReferencePoint> reference;
+    for (auto &[steps_per_iteration, front] : fronts) {
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, front.solutions);
+        flexman::search::remove_duplicate_solutions<State, Resources>(front.solutions);
+        if constexpr (EnergyTimeResources<Resources>) {
+            if (!reference) {
+                reference = flexman::search::reference_point(front.solutions);
+            }
+            front.hypervolume = flexman::search::hypervolume(front.solutions, *reference);
+        }
+        qinfo(
+            logging::search, "Stride %5u: merged %u solutions, archive holds %u.\n", steps_per_iteration,
+            front.solutions.size(), archive.size());
+        result.pareto_fronts.emplace_back(std::move(front));
+    }
+    return result;
+#endif
+}
+
+} // namespace search
+} // namespace flexman
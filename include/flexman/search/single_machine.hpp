@@ -0,0 +1,271 @@
+/// @file single_machine.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the fast path of the single-machine search.
+///
+/// @details
+/// The single-machine search never switches mode, hence, each partial solution
+/// evolves alone, and the iterations only decide which of them are discarded,
+/// and when the complete ones enter the Pareto front. Running it through the
+/// generic iterations extends, filters, splits and logs all the partial
+/// solutions at every step. This file provides
+/// `perform_single_machine_n_iterations`, which instead:
+/// 1. Simulates the trajectory of each mode in parallel, with the same calls
+///    of the generic iterations, until it completes.
+/// 2. Replays the iterations over the trajectories, running the dominance
+///    filters, the split and the removal of duplicates only at the steps where
+///    they can change something, i.e., when a solution completes, or when the
+///    front is not empty.
+///
+/// The resulting front is the same of the generic iterations, solution by
+/// solution and in the same order.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <timelib/timer.hpp>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/core/pareto_front.hpp"
+#include "flexman/core/solution.hpp"
+#include "flexman/executor.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/search/common.hpp"
+#include "flexman/search/counters.hpp"
+
+namespace flexman
+{
+namespace search
+{
+
+/// @brief Checks if the fast path of the single-machine search reproduces the
+/// generic iterations under the given parameters.
+///
+/// @details The rollout, the cost model, and the exchange of solutions with
+/// other searches act on the partial solutions between the iterations, hence,
+/// they require the generic iterations.
+///
+/// @param parameters The search parameters.
+/// @param exchanging Whether the accepted solutions are exchanged with other searches.
+///
+/// @return True if the fast path can be used, false otherwise.
+inline auto supports_single_machine_fast_path(const SearchParameters &parameters, bool exchanging) -> bool
+{
+    return !exchanging && (parameters.rollout_samples == 0) && !parameters.cost_model;
+}
+
+/// @brief Performs the iterations of the single-machine search, by simulating
+/// each mode alone, and replaying the filters of the generic iterations.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager handling the search process.
+/// @param modes The set of modes available for simulation.
+/// @param steps_per_iteration The number of steps simulated per iteration.
+/// @param previous_pareto_front The previous Pareto front of solutions, whose
+/// solutions are moved into the returned front.
+/// @param global_timer The global timer to track the search process duration.
+/// @param parameters The search parameters.
+///
+/// @return The updated Pareto front after performing the iterations.
+template <typename State, typename Mode, typename Resources>
+auto perform_single_machine_n_iterations(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const unsigned steps_per_iteration,
+    flexman::core::ParetoFront<State, Resources> previous_pareto_front,
+    const timelib::Timer &global_timer,
+    const SearchParameters &parameters = SearchParameters()) -> flexman::core::ParetoFront<State, Resources>
+{
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    // Check if manager is a valid pointer.
+    if (!manager) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+
+    // Check if steps_per_iteration is a positive number.
+    if (steps_per_iteration == 0) {
+        throw std::invalid_argument("steps_per_iteration must be greater than 0");
+    }
+
+    // Check if modes vector is not empty.
+    if (modes.empty()) {
+        throw std::invalid_argument("modes vector is empty");
+    }
+
+    // The modes we are allowed to start from, in the order of the generic iterations.
+    std::vector<flexman::core::ModeId> started;
+    for (const auto &mode : modes) {
+        if (parameters.initial_modes.empty() ||
+            std::find(parameters.initial_modes.begin(), parameters.initial_modes.end(), mode.id) !=
+                parameters.initial_modes.end()) {
+            started.emplace_back(mode.id);
+        }
+    }
+
+    // A stopwatch to check runtime.
+    timelib::Timer pareto_timer;
+    pareto_timer.start();
+
+    // Calculate the time covered in each iteration.
+    const double time_per_iteration = manager->time_delta * static_cast<double>(steps_per_iteration);
+
+    // Determine the maximum number of steps allowed.
+    const auto max_iterations = static_cast<unsigned>(manager->time_max / time_per_iteration);
+
+    // Simulate the trajectory of each mode in parallel, until it completes.
+    // Each iteration extends the solution as `extend_solutions` does.
+    std::vector<std::vector<solution_t>> trajectories(started.size());
+    auto simulate = [&](std::size_t slot) {
+        // The counters measure the calling thread, hence, each trajectory is
+        // measured by the thread that simulates it.
+        PhaseRecorder trajectory_recorder(parameters.counters.get());
+        trajectory_recorder.start();
+        auto &trajectory = trajectories[slot];
+        trajectory.reserve(max_iterations);
+        solution_t solution{
+            .sequence  = {{started[slot], 0}},
+            .state     = manager->initial_state,
+            .resources = Resources(),
+            .distance  = std::numeric_limits<double>::max(),
+        };
+        for (unsigned iteration = 0; iteration < max_iterations; ++iteration) {
+            solution = flexman::search::simulate_mode(
+                manager, modes[solution.sequence.back().mode], steps_per_iteration, solution);
+            trajectory.emplace_back(solution);
+            if (manager->is_complete(solution) || global_timer.has_timeout()) {
+                break;
+            }
+        }
+        trajectory_recorder.stop(SearchPhase::Extension, trajectory.size());
+    };
+    const std::size_t workers = std::min<std::size_t>(started.size(), std::thread::hardware_concurrency());
+    if (workers > 1) {
+        flexman::parallel::Executor executor(workers);
+        std::vector<std::future<void>> futures;
+        futures.reserve(started.size());
+        for (std::size_t slot = 0; slot < started.size(); ++slot) {
+            futures.emplace_back(executor.submit([&simulate, slot]() { simulate(slot); }));
+        }
+        for (auto &future : futures) {
+            future.get();
+        }
+    } else {
+        for (std::size_t slot = 0; slot < started.size(); ++slot) {
+            simulate(slot);
+        }
+    }
+    std::size_t simulated = 0;
+    for (const auto &trajectory : trajectories) {
+        simulated += trajectory.size();
+    }
+
+    // Find the slot of each mode.
+    std::unordered_map<flexman::core::ModeId, std::size_t> slot_of;
+    for (std::size_t slot = 0; slot < started.size(); ++slot) {
+        slot_of.emplace(started[slot], slot);
+    }
+
+    // Replay the iterations, the partial solutions are the slots of their modes.
+    std::vector<solution_t> accepted_solutions = std::move(previous_pareto_front.solutions);
+    std::vector<std::size_t> partial_slots(started.size());
+    for (std::size_t slot = 0; slot < started.size(); ++slot) {
+        partial_slots[slot] = slot;
+    }
+    std::vector<solution_t> extended;
+    std::vector<solution_t> complete;
+    std::vector<solution_t> partial;
+
+    // Measures the replay, if requested.
+    PhaseRecorder recorder(parameters.counters.get());
+    recorder.start();
+    unsigned iteration = 0;
+    while ((iteration < max_iterations) && !partial_slots.empty()) {
+        // The trajectories stop early only when the search timed out.
+        bool truncated = false;
+        bool completes = false;
+        for (const std::size_t slot : partial_slots) {
+            if (iteration >= trajectories[slot].size()) {
+                truncated = true;
+                break;
+            }
+            completes = completes || manager->is_complete(trajectories[slot][iteration]);
+        }
+        if (truncated) {
+            break;
+        }
+        ++iteration;
+
+        // With no complete solution, the iteration can only discard partial
+        // solutions, dominated by the accepted ones.
+        if (!completes) {
+            if (!accepted_solutions.empty()) {
+                std::erase_if(partial_slots, [&](std::size_t slot) {
+                    const auto &solution = trajectories[slot][iteration - 1];
+                    return std::any_of(
+                        accepted_solutions.begin(), accepted_solutions.end(),
+                        [&](const auto &other) { return manager->is_strictly_better_than(other, solution); });
+                });
+            }
+            continue;
+        }
+
+        // Otherwise, run the filters of the generic iteration.
+        extended.clear();
+        for (const std::size_t slot : partial_slots) {
+            extended.emplace_back(trajectories[slot][iteration - 1]);
+        }
+        flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(
+            manager, extended, accepted_solutions);
+        flexman::search::split_complete_partial(manager, extended, complete, partial);
+        if (!complete.empty()) {
+            flexman::search::move_elements(complete, accepted_solutions);
+            flexman::search::remove_dominated_solutions<SearchAlgorithm::Exhaustive>(manager, accepted_solutions);
+            flexman::search::remove_duplicate_solutions(accepted_solutions);
+        }
+        partial_slots.clear();
+        for (const auto &solution : partial) {
+            partial_slots.emplace_back(slot_of.at(solution.sequence.front().mode));
+        }
+        partial.clear();
+    }
+    recorder.stop(SearchPhase::Dominance, simulated);
+
+    if (global_timer.has_timeout()) {
+        qwarning(
+            logging::round, "Single-machine search went into timeout after %u of %u iterations (%.2f > %.2f).\n",
+            iteration, max_iterations, global_timer.elapsed().count(), manager->timeout.count());
+    }
+    qinfo(
+        logging::round, "Simulated %u modes alone, with %u extensions, over %u iterations of %u steps: %u accepted.\n",
+        started.size(), simulated, iteration, steps_per_iteration, accepted_solutions.size());
+
+    return flexman::core::ParetoFront<State, Resources>{
+        .solutions           = std::move(accepted_solutions),  // The final set of accepted solutions.
+        .step_length         = time_per_iteration,             // The length of each iteration.
+        .steps_per_iteration = steps_per_iteration,            // The number of steps per iteration.
+        .iteration           = iteration,                      // The total number of iterations performed.
+        .runtime             = pareto_timer.elapsed().count(), // The runtime of the search process.
+        .hypervolume         = 0.0,                            // Computed by the caller, if needed.
+    };
+}
+
+} // namespace search
+} // namespace flexman
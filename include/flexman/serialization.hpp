@@ -12,6 +12,8 @@
 /// - `ParetoFront`
 /// - `Result`
 /// - `Manager`
+/// - `CostModel`
+/// - `linear::Resources`
 ///
 /// These operators facilitate seamless conversion between JSON representations
 /// and Flexman objects, enabling efficient data storage, logging, and
@@ -86,6 +88,7 @@ inline auto operator<<(json::jnode_t &lhs, const flexman::core::ParetoFront<Stat
     lhs["steps_per_iteration"] << rhs.steps_per_iteration;
     lhs["iteration"] << rhs.iteration;
     lhs["runtime"] << rhs.runtime;
+    lhs["hypervolume"] << rhs.hypervolume;
     return lhs;
 }
 
@@ -104,8 +107,12 @@ inline auto operator>>(const json::jnode_t &lhs, flexman::core::ParetoFront<Stat
 {
     lhs["solutions"] >> rhs.solutions;
     lhs["step_length"] >> rhs.step_length;
-    lhs["step"] >> rhs.step;
+    lhs["steps_per_iteration"] >> rhs.steps_per_iteration;
+    lhs["iteration"] >> rhs.iteration;
     lhs["runtime"] >> rhs.runtime;
+    if (lhs.has_property("hypervolume")) {
+        lhs["hypervolume"] >> rhs.hypervolume;
+    }
     return lhs;
 }
 
@@ -123,6 +130,7 @@ inline auto operator<<(json::jnode_t &lhs, const flexman::core::Result<State, Re
 {
     lhs.set_type(json::JTYPE_OBJECT);
     lhs["pareto_fronts"] << rhs.pareto_fronts;
+    lhs["stop_reason"] << static_cast<unsigned>(rhs.stop_reason);
     return lhs;
 }
 
@@ -139,6 +147,11 @@ template <typename State, typename Resources>
 inline auto operator>>(const json::jnode_t &lhs, flexman::core::Result<State, Resources> &rhs) -> const json::jnode_t &
 {
     lhs["pareto_fronts"] >> rhs.pareto_fronts;
+    if (lhs.has_property("stop_reason")) {
+        unsigned stop_reason = 0;
+        lhs["stop_reason"] >> stop_reason;
+        rhs.stop_reason = static_cast<flexman::core::StopReason>(stop_reason);
+    }
     return lhs;
 }
 
@@ -257,4 +270,70 @@ inline auto operator>>(const json::jnode_t &lhs, flexman::core::Manager<State, M
     return lhs;
 }
 
+/// @brief Serializes a CostModel object to a JSON node.
+///
+/// @param lhs The JSON node to write to.
+/// @param rhs The CostModel object to serialize.
+///
+/// @return A reference to the updated JSON node.
+inline auto operator<<(json::jnode_t &lhs, const flexman::search::CostModel &rhs) -> json::jnode_t &
+{
+    lhs.set_type(json::JTYPE_OBJECT);
+    lhs["mean"] << rhs.mean;
+    lhs["scale"] << rhs.scale;
+    lhs["energy_weights"] << rhs.energy_weights;
+    lhs["time_weights"] << rhs.time_weights;
+    lhs["margin"] << rhs.margin;
+    return lhs;
+}
+
+/// @brief Deserializes a CostModel object from a JSON node.
+///
+/// @param lhs The JSON node to read from.
+/// @param rhs The CostModel object to populate.
+///
+/// @return A reference to the original JSON node.
+inline auto operator>>(const json::jnode_t &lhs, flexman::search::CostModel &rhs) -> const json::jnode_t &
+{
+    lhs["mean"] >> rhs.mean;
+    lhs["scale"] >> rhs.scale;
+    lhs["energy_weights"] >> rhs.energy_weights;
+    lhs["time_weights"] >> rhs.time_weights;
+    lhs["margin"] >> rhs.margin;
+    return lhs;
+}
+
+/// @brief Serializes the resources of the linear managers to a JSON node.
+///
+/// @tparam Scalar The scalar type of the resources.
+///
+/// @param lhs The JSON node to write to.
+/// @param rhs The resources to serialize.
+///
+/// @return A reference to the updated JSON node.
+template <typename Scalar>
+inline auto operator<<(json::jnode_t &lhs, const flexman::linear::Resources<Scalar> &rhs) -> json::jnode_t &
+{
+    lhs.set_type(json::JTYPE_OBJECT);
+    lhs["energy"] << rhs.energy;
+    lhs["time"] << rhs.time;
+    return lhs;
+}
+
+/// @brief Deserializes the resources of the linear managers from a JSON node.
+///
+/// @tparam Scalar The scalar type of the resources.
+///
+/// @param lhs The JSON node to read from.
+/// @param rhs The resources to populate.
+///
+/// @return A reference to the original JSON node.
+template <typename Scalar>
+inline auto operator>>(const json::jnode_t &lhs, flexman::linear::Resources<Scalar> &rhs) -> const json::jnode_t &
+{
+    lhs["energy"] >> rhs.energy;
+    lhs["time"] >> rhs.time;
+    return lhs;
+}
+
 } // namespace json
@@ -0,0 +1,324 @@
+/// @file parareal.hpp
+/// @author Enrico Fraccaroli (enrico.fraccaroli@univr.it)
+///
+/// @brief Implements the parallel-in-time simulation of a single mode.
+///
+/// @details
+/// Simulating a mode over a long horizon is inherently serial, each step
+/// starts from the state of the previous one. The Parareal method splits the
+/// horizon in slices, and iterates two propagators:
+/// - A coarse propagator, a second manager with cheaper and larger steps,
+///   sweeps serially over the slices to predict the state at their boundaries.
+/// - The fine propagator, the manager of the simulation, advances all the
+///   slices in parallel, each one from its predicted boundary.
+///
+/// Each iteration corrects the boundaries with `G(new) + F(old) - G(old)`,
+/// and makes at least one more slice exact; the iterations stop once the
+/// boundaries move less than the tolerance. The correction is computed by
+/// extrapolating with `interpolate_state` and `interpolate_resources`, hence,
+/// the manager must interpolate linearly, also outside the interval.
+///
+/// The function `compare_simulations` reports the error of a simulation
+/// against a reference, e.g., the one of `simulate_single_mode`.
+///
+/// @copyright Copyright (c) 2024-2025 Enrico Fraccaroli, University of Verona,
+/// University of North Carolina at Chapel Hill. Distributed under the BSD
+/// 3-Clause License. See LICENSE.md for details.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "flexman/core/manager.hpp"
+#include "flexman/executor.hpp"
+#include "flexman/logging.hpp"
+#include "flexman/simulation/simulate.hpp"
+
+namespace flexman
+{
+namespace simulation
+{
+
+/// @brief States whose components can be compared one by one.
+template <typename State>
+concept IndexableState = requires(const State &state, std::size_t index) {
+    { state.size() } -> std::convertible_to<std::size_t>;
+    { state[index] } -> std::convertible_to<double>;
+};
+
+/// @brief The parameters of the Parareal simulation.
+struct PararealParameters {
+    /// @brief The number of slices of the horizon, zero uses one per worker of the executor.
+    std::size_t slices      = 0;
+    /// @brief The maximum number of iterations, zero allows one per slice, after which the result is exact.
+    unsigned max_iterations = 0;
+    /// @brief The largest change of a boundary state, below which the iterations stop.
+    double tolerance        = 1e-9;
+};
+
+/// @brief How a Parareal simulation went.
+struct PararealReport {
+    /// @brief The number of slices of the horizon.
+    std::size_t slices = 0;
+    /// @brief The number of iterations performed.
+    unsigned iterations = 0;
+    /// @brief The largest change of a boundary state in the last iteration.
+    double correction = 0;
+    /// @brief Whether the boundaries converged, rather than hitting the maximum number of iterations.
+    bool converged = false;
+};
+
+/// @brief The error of a simulation against a reference.
+struct SimulationError {
+    /// @brief The largest difference of a state component, over the common steps.
+    double state = 0;
+    /// @brief The largest difference of the distance from the target, over the common steps.
+    double distance = 0;
+    /// @brief The number of steps of the simulation minus the ones of the reference.
+    long steps = 0;
+};
+
+/// @brief Computes the largest difference between the components of two states.
+///
+/// @tparam State The type representing the state.
+///
+/// @param a The first state.
+/// @param b The second state.
+///
+/// @return The largest difference, infinite if the states do not have the same size.
+template <IndexableState State>
+auto state_difference(const State &a, const State &b) -> double
+{
+    if (a.size() != b.size()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double difference = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const double delta = std::abs(static_cast<double>(a[i]) - static_cast<double>(b[i]));
+        // Propagate the divergence of a state.
+        difference = std::isnan(delta) ? std::numeric_limits<double>::infinity() : std::max(difference, delta);
+    }
+    return difference;
+}
+
+/// @brief Compares a simulation against a reference, step by step.
+///
+/// @tparam State The type representing the state.
+/// @tparam Resources The type representing the resources.
+///
+/// @param reference The reference simulation.
+/// @param simulation The simulation to compare.
+///
+/// @return The error of the simulation.
+template <IndexableState State, typename Resources>
+auto compare_simulations(const Simulation<State, Resources> &reference, const Simulation<State, Resources> &simulation)
+    -> SimulationError
+{
+    SimulationError error{
+        .state    = 0,
+        .distance = 0,
+        .steps    = static_cast<long>(simulation.evolution.size()) - static_cast<long>(reference.evolution.size()),
+    };
+    const std::size_t common = std::min(reference.evolution.size(), simulation.evolution.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        const auto &expected = reference.evolution[i];
+        const auto &actual   = simulation.evolution[i];
+        error.state          = std::max(error.state, state_difference(expected.state, actual.state));
+        error.distance       = std::max(error.distance, std::abs(expected.distance - actual.distance));
+    }
+    return error;
+}
+
+/// @brief Simulates a mode with the Parareal method.
+///
+/// @details The result follows `simulate_single_mode`, it holds a solution per
+/// step of the fine propagator, and ends with the first complete one. The
+/// coarse manager takes the steps that cover the same time of a slice, hence,
+/// its time delta should divide the one of a slice. Both managers are used
+/// concurrently, through their const interface.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager, the fine propagator.
+/// @param coarse Pointer to the manager of the coarse propagator.
+/// @param mode The mode being simulated.
+/// @param steps The number of steps of the fine propagator to simulate.
+/// @param parameters The parameters of the method.
+/// @param executor The executor running the fine propagator.
+/// @param report Where the outcome of the iterations is written, if not null.
+///
+/// @return The simulation.
+template <IndexableState State, typename Mode, typename Resources>
+auto simulate_single_mode_parareal(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const flexman::core::Manager<State, Mode, Resources> *coarse,
+    const Mode &mode,
+    const unsigned steps,
+    const PararealParameters &parameters,
+    flexman::parallel::Executor &executor,
+    PararealReport *report = nullptr) -> Simulation<State, Resources>
+{
+    using solution_t = flexman::core::Solution<State, Resources>;
+
+    // Check for null pointers in the managers.
+    if ((manager == nullptr) || (coarse == nullptr)) {
+        throw std::invalid_argument("manager pointer is null");
+    }
+    // Check if steps is a valid number.
+    if (steps == 0) {
+        throw std::invalid_argument("steps must be greater than 0");
+    }
+    if (!(coarse->time_delta > 0)) {
+        throw std::invalid_argument("the time delta of the coarse manager must be greater than 0");
+    }
+
+    // Split the horizon in slices of (almost) equal length.
+    const std::size_t slices = std::clamp<std::size_t>(
+        (parameters.slices == 0) ? executor.size() : parameters.slices, 1, static_cast<std::size_t>(steps));
+    std::vector<unsigned> first_step(slices + 1);
+    for (std::size_t j = 0; j <= slices; ++j) {
+        first_step[j] = static_cast<unsigned>((static_cast<std::size_t>(steps) * j) / slices);
+    }
+    const unsigned max_iterations =
+        (parameters.max_iterations == 0) ? static_cast<unsigned>(slices) : parameters.max_iterations;
+
+    // The coarse propagator, covering the time of a slice.
+    auto propagate_coarse = [&](solution_t solution, std::size_t j) {
+        const double span = static_cast<double>(first_step[j + 1] - first_step[j]) * manager->time_delta;
+        const auto count  = std::max(1L, std::lround(span / coarse->time_delta));
+        for (long i = 0; (i < count) && !coarse->is_complete(solution); ++i) {
+            coarse->updated_solution(solution, mode);
+        }
+        return solution;
+    };
+    // The fine propagator, keeping a solution per step, as `simulate_single_mode`.
+    auto propagate_fine = [&](solution_t solution, std::size_t j) {
+        std::vector<solution_t> evolution;
+        evolution.reserve(first_step[j + 1] - first_step[j]);
+        for (unsigned i = first_step[j]; (i < first_step[j + 1]) && !manager->is_complete(solution); ++i) {
+            manager->updated_solution(solution, mode);
+            evolution.emplace_back(solution);
+        }
+        return evolution;
+    };
+    // The state reached by a slice, its start if it did not take any step.
+    std::vector<std::vector<solution_t>> fine(slices);
+    std::vector<solution_t> boundary(slices + 1);
+    auto fine_end = [&](std::size_t j) -> const solution_t & {
+        return fine[j].empty() ? boundary[j] : fine[j].back();
+    };
+    // Whether the trajectory, as refined so far, ends within the slice.
+    auto ends_in = [&](std::size_t j) {
+        return fine[j].empty() || manager->is_complete(fine[j].back());
+    };
+    // The correction, predicted + fine - coarse, by extrapolating linearly.
+    auto correct = [&](const solution_t &predicted, const solution_t &refined, const solution_t &previous) {
+        solution_t solution = predicted;
+        solution.state      = manager->interpolate_state(
+            previous.state, manager->interpolate_state(predicted.state, refined.state, 0.5), 2.0);
+        solution.resources = manager->interpolate_resources(
+            previous.resources, manager->interpolate_resources(predicted.resources, refined.resources, 0.5), 2.0);
+        solution.distance = manager->distance(solution);
+        return solution;
+    };
+
+    // Predict the boundaries with a coarse sweep.
+    boundary[0] = solution_t{
+        .sequence  = {},
+        .state     = manager->initial_state,
+        .resources = Resources(),
+        .distance  = std::numeric_limits<double>::max(),
+    };
+    std::vector<solution_t> predicted(slices + 1);
+    for (std::size_t j = 0; j < slices; ++j) {
+        predicted[j + 1] = propagate_coarse(boundary[j], j);
+        boundary[j + 1]  = predicted[j + 1];
+    }
+
+    PararealReport outcome{.slices = slices, .iterations = 0, .correction = 0, .converged = false};
+    // The slices before this one start from an exact boundary, and are final.
+    std::size_t exact = 0;
+    // The slices from this one on follow the end of the trajectory.
+    std::size_t last = slices;
+    while ((exact < last) && (outcome.iterations < max_iterations)) {
+        ++outcome.iterations;
+        // Refine the slices that are not final, in parallel.
+        std::vector<std::future<std::vector<solution_t>>> futures;
+        futures.reserve(last - exact);
+        for (std::size_t j = exact; j < last; ++j) {
+            futures.emplace_back(executor.submit([&propagate_fine, &boundary, j]() {
+                return propagate_fine(boundary[j], j);
+            }));
+        }
+        for (std::size_t j = exact; j < last; ++j) {
+            fine[j] = futures[j - exact].get();
+        }
+        // The first slice that is not final started from an exact boundary.
+        bool ended         = ends_in(exact);
+        outcome.correction = ended ? 0.0 : state_difference(fine_end(exact).state, boundary[exact + 1].state);
+        boundary[exact + 1] = fine_end(exact);
+        for (std::size_t j = exact + 1; j < last; ++j) {
+            // Correct the boundary with the coarse propagation of the corrected start.
+            const solution_t refined = propagate_coarse(boundary[j], j);
+            const solution_t updated = correct(refined, fine_end(j), predicted[j + 1]);
+            // The boundaries past the end of the trajectory do not affect it.
+            ended = ended || ends_in(j);
+            if (!ended) {
+                const double change = state_difference(updated.state, boundary[j + 1].state);
+                outcome.correction  = std::max(outcome.correction, change);
+            }
+            predicted[j + 1] = refined;
+            boundary[j + 1]  = updated;
+        }
+        // The trajectory ends within an exact slice, the following ones are not needed.
+        if (ends_in(exact)) {
+            last = exact + 1;
+        }
+        ++exact;
+        qdebug(
+            logging::round, "Parareal iteration %u: %u of %u slices exact, correction %g.\n", outcome.iterations, exact,
+            last, outcome.correction);
+        if (outcome.correction <= parameters.tolerance) {
+            break;
+        }
+    }
+    outcome.converged = (exact >= last) || (outcome.correction <= parameters.tolerance);
+    if (!outcome.converged) {
+        qwarning(
+            logging::round, "Parareal did not converge in %u iterations, correction %g.\n", outcome.iterations,
+            outcome.correction);
+    }
+    if (report != nullptr) {
+        *report = outcome;
+    }
+
+    // Join the slices, up to the first complete solution.
+    Simulation<State, Resources> simulation{
+        .evolution     = {},
+        .initial_state = manager->initial_state,
+        .target_state  = manager->target_state,
+    };
+    simulation.evolution.reserve(steps);
+    for (std::size_t j = 0; j < last; ++j) {
+        for (const auto &solution : fine[j]) {
+            simulation.evolution.emplace_back(solution);
+            if (manager->is_complete(solution)) {
+                return simulation;
+            }
+        }
+    }
+    return simulation;
+}
+
+} // namespace simulation
+} // namespace flexman
@@ -9,6 +9,10 @@
 /// execution sequences. It includes:
 /// - `generate_solution`: Simulates a sequence of mode executions to generate
 ///   a resulting solution.
+/// - `generate_bounded_solution`: Like `generate_solution`, but stops as soon
+///   as the solution can not beat a cutoff.
+/// - `generate_repaired_solution`: Like `generate_solution`, but extends the
+///   last mode of a sequence that does not reach the target.
 /// - `simulate_one_step`: Performs a single-step simulation update.
 /// - `simulate_single_mode`: Simulates a mode for a specified number of steps,
 ///   tracking state evolution over time.
@@ -26,6 +30,9 @@
 #include "flexman/search/common.hpp"
 #include "flexman/simulation/common.hpp"
 
+#include <limits>
+#include <optional>
+
 namespace flexman
 {
 
@@ -82,6 +89,161 @@ auto generate_solution(
     return solution;
 }
 
+/// @brief Generates a solution by simulating a sequence of mode executions,
+/// unless it is worse than a cutoff.
+///
+/// @details The simulation stops as soon as the lower bound of an incomplete
+/// solution reaches the cutoff. The lower bound must never decrease along a
+/// simulation, e.g., a sum of accumulated resources, hence, the solution the
+/// full simulation would generate can not be better than the cutoff. When it
+/// does not stop, it generates the same solution of `generate_solution`.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+/// @tparam LowerBound The type of the lower bound, called as `lower_bound(solution)`.
+///
+/// @param manager Pointer to the manager that handles solution updates and evaluation.
+/// @param modes The vector of modes available for execution.
+/// @param sequence The sequence of mode executions to simulate.
+/// @param cutoff The cutoff.
+/// @param lower_bound The lower bound of the solutions the simulation can still generate.
+///
+/// @return The generated solution, or nothing if it is worse than the cutoff.
+template <typename State, typename Mode, typename Resources, typename LowerBound>
+auto generate_bounded_solution(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    const std::vector<flexman::core::ModeExecution> &sequence,
+    double cutoff,
+    const LowerBound &lower_bound) -> std::optional<flexman::core::Solution<State, Resources>>
+{
+    // Initialize the solution with an empty state and resources.
+    flexman::core::Solution<State, Resources> solution{
+        .sequence  = {},
+        .state     = manager->initial_state,
+        .resources = Resources(),
+        .distance  = std::numeric_limits<double>::max(),
+    };
+    // Simulate the mode sequence.
+    for (const auto &mode_execution : sequence) {
+        // Apply the mode the specified number of times
+        for (std::size_t i = 0; i < mode_execution.times; ++i) {
+            // Store the previous solution.
+            auto old_solution = solution;
+            // Update the solution.
+            manager->updated_solution(solution, modes[mode_execution.mode]);
+            // Add the mode to the sequence.
+            flexman::core::detail::add_mode_execution_to_sequence(mode_execution.mode, solution.sequence);
+            // If the solution is complete, interpolate to avoid overshoot.
+            if (manager->is_complete(solution)) {
+                solution = flexman::search::find_solution_closest_to_zero(manager, old_solution, solution);
+                break;
+            }
+            // Stop if the rest of the simulation can not beat the cutoff.
+            if (!(lower_bound(solution) < cutoff)) {
+                return std::nullopt;
+            }
+        }
+    }
+    return solution;
+}
+
+/// @brief Generates a solution by simulating a sequence of mode executions,
+/// and repairs the sequence if it does not complete, unless the solution is
+/// worse than a cutoff.
+///
+/// @details When the sequence ends before reaching the target, the last mode
+/// keeps running, in the same simulation pass, until the solution completes,
+/// or the whole sequence covers `time_max`. The executions added to the last
+/// mode are written back into the sequence, hence, simulating the repaired
+/// sequence with `generate_solution` gives the same solution. The simulation
+/// stops as in `generate_bounded_solution`, and then leaves the sequence as it
+/// is.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+/// @tparam LowerBound The type of the lower bound, called as `lower_bound(solution)`.
+///
+/// @param manager Pointer to the manager that handles solution updates and evaluation.
+/// @param modes The vector of modes available for execution.
+/// @param sequence The sequence of mode executions to simulate, repaired in place.
+/// @param cutoff The cutoff.
+/// @param lower_bound The lower bound of the solutions the simulation can still generate.
+///
+/// @return The generated solution, which is incomplete only if the repair
+/// failed, or nothing if it is worse than the cutoff.
+template <typename State, typename Mode, typename Resources, typename LowerBound>
+auto generate_repaired_solution(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    std::vector<flexman::core::ModeExecution> &sequence,
+    double cutoff,
+    const LowerBound &lower_bound) -> std::optional<flexman::core::Solution<State, Resources>>
+{
+    // Simulate the sequence as it is.
+    auto result = flexman::simulation::generate_bounded_solution(manager, modes, sequence, cutoff, lower_bound);
+    if (!result || sequence.empty() || manager->is_complete(*result)) {
+        return result;
+    }
+    auto &solution = *result;
+    // Count the steps left before the sequence covers the maximum time.
+    std::size_t steps = 0;
+    for (const auto &mode_execution : sequence) {
+        steps += mode_execution.times;
+    }
+    const auto max_steps = static_cast<std::size_t>(manager->time_max / manager->time_delta);
+    // Extend the last mode until the solution completes.
+    const auto mode       = sequence.back().mode;
+    std::size_t extension = 0;
+    for (; steps < max_steps; ++steps) {
+        // Store the previous solution.
+        auto old_solution = solution;
+        // Update the solution.
+        manager->updated_solution(solution, modes[mode]);
+        // Add the mode to the sequence, and to the repaired execution.
+        flexman::core::detail::add_mode_execution_to_sequence(mode, solution.sequence);
+        ++extension;
+        // If the solution is complete, interpolate to avoid overshoot.
+        if (manager->is_complete(solution)) {
+            solution = flexman::search::find_solution_closest_to_zero(manager, old_solution, solution);
+            break;
+        }
+        // Stop if the rest of the simulation can not beat the cutoff.
+        if (!(lower_bound(solution) < cutoff)) {
+            return std::nullopt;
+        }
+    }
+    sequence.back().times += extension;
+    return result;
+}
+
+/// @brief Generates a solution by simulating a sequence of mode executions,
+/// and repairs the sequence if it does not complete.
+///
+/// @details See the bounded version, the simulation never stops early.
+///
+/// @tparam State The type representing the state.
+/// @tparam Mode The type representing the mode.
+/// @tparam Resources The type representing the resources.
+///
+/// @param manager Pointer to the manager that handles solution updates and evaluation.
+/// @param modes The vector of modes available for execution.
+/// @param sequence The sequence of mode executions to simulate, repaired in place.
+///
+/// @return The generated solution, which is incomplete only if the repair failed.
+template <typename State, typename Mode, typename Resources>
+auto generate_repaired_solution(
+    const flexman::core::Manager<State, Mode, Resources> *manager,
+    const std::vector<Mode> &modes,
+    std::vector<flexman::core::ModeExecution> &sequence) -> flexman::core::Solution<State, Resources>
+{
+    return *flexman::simulation::generate_repaired_solution(
+        manager, modes, sequence, std::numeric_limits<double>::infinity(),
+        [](const auto &) { return -std::numeric_limits<double>::infinity(); });
+}
+
 /// @brief Simulates one step and updates the solution.
 ///
 /// @tparam State The type representing the state.